@@ -1,5 +1,6 @@
 #include "Animations_BT.h"
 #include "GUI_BT.h"
+#include "../General/sprite_cache.h"
 
 #include <QPainterPath>
 #include <QVariantAnimation>
@@ -31,7 +32,7 @@ void Animations_BT::animateTrainerThrow(BattleSequence* b, std::function<void()>
     QVector<QPixmap> frames;
     for (int i = 1; i <= 5; ++i) {
         QString path = QString(":/assets/battle/battle_player%1.png").arg(i);
-        QPixmap px(path);
+        QPixmap px = SpriteCache::pixmap(path);
         if (!px.isNull())
             frames.push_back(px);
     }
@@ -47,7 +48,7 @@ void Animations_BT::animateTrainerThrow(BattleSequence* b, std::function<void()>
     throwSprite->setPos(b->battleTrainerItem->pos());
     b->battleTrainerItem->setVisible(false);
 
-    QPixmap pokeballPx(":/assets/battle/pokeball.png");
+    QPixmap pokeballPx = SpriteCache::pixmap(":/assets/battle/pokeball.png");
     if (pokeballPx.isNull()) {
         pokeballPx = QPixmap(24, 24);
         pokeballPx.fill(Qt::transparent);
@@ -80,7 +81,7 @@ void Animations_BT::animateTrainerThrow(BattleSequence* b, std::function<void()>
 
     int frameIndex = 0;
     QTimer *timer = new QTimer(b);
-    timer->setInterval(100);
+    timer->setInterval(b->timeline.scaled(100));
 
     QObject::connect(timer, &QTimer::timeout, b,
                      [=]() mutable
@@ -91,7 +92,7 @@ void Animations_BT::animateTrainerThrow(BattleSequence* b, std::function<void()>
                              pokeball->setVisible(true);
 
                              QVariantAnimation *throwAnim = new QVariantAnimation(b);
-                             throwAnim->setDuration(450);
+                             throwAnim->setDuration(b->timeline.scaled(450));
                              throwAnim->setStartValue(0.0);
                              throwAnim->setEndValue(1.0);
                              throwAnim->setEasingCurve(QEasingCurve::InOutQuad);
@@ -115,83 +116,31 @@ void Animations_BT::animateTrainerThrow(BattleSequence* b, std::function<void()>
                                                   qreal ballCenterX = pokeball->x() + 12;
                                                   qreal ballCenterY = pokeball->y() + 12;
 
-                                                  QGraphicsEllipseItem *openFlash = new QGraphicsEllipseItem(
-                                                      ballCenterX - 40,
-                                                      ballCenterY - 40,
-                                                      80, 80
-                                                      );
-                                                  openFlash->setBrush(Qt::white);
-                                                  openFlash->setPen(Qt::NoPen);
-                                                  openFlash->setOpacity(0.0);
-                                                  openFlash->setZValue(1001);
-                                                  scene->addItem(openFlash);
-
-                                                  QVariantAnimation *openAnim = new QVariantAnimation(b);
-                                                  openAnim->setDuration(400);
-                                                  openAnim->setStartValue(0.0);
-                                                  openAnim->setKeyValueAt(0.15, 1.0);
-                                                  openAnim->setKeyValueAt(0.5, 0.8);
-                                                  openAnim->setEndValue(0.0);
-
-                                                  QObject::connect(openAnim, &QVariantAnimation::valueChanged,
-                                                                   [=](const QVariant &v) {
-                                                                       qreal t = v.toReal();
-                                                                       openFlash->setOpacity(t);
-                                                                       qreal size = 80 + t * 40;
-                                                                       openFlash->setRect(
-                                                                           ballCenterX - size/2,
-                                                                           ballCenterY - size/2,
-                                                                           size, size
-                                                                           );
-                                                                   });
-
-                                                  QObject::connect(openAnim, &QVariantAnimation::finished,
-                                                                   [=]() {
-                                                                       scene->removeItem(openFlash);
-                                                                       delete openFlash;
-                                                                   });
-
-                                                  openAnim->start(QAbstractAnimation::DeleteWhenStopped);
+                                                  EffectSpec openFlash;
+                                                  openFlash.center = QPointF(ballCenterX, ballCenterY);
+                                                  openFlash.startSize = 80;
+                                                  openFlash.endSize = 120;
+                                                  openFlash.z = 1001;
+                                                  openFlash.durationMs = b->timeline.scaled(400);
+                                                  openFlash.peakAt = 0.15;
+                                                  openFlash.holdAt = 0.5;
+                                                  openFlash.holdLevel = 0.8;
+                                                  b->effects.spawn(openFlash);
 
                                                   for (int i = 0; i < 5; ++i) {
-                                                      QGraphicsEllipseItem *particle = new QGraphicsEllipseItem(
-                                                          ballCenterX - 3,
-                                                          ballCenterY - 3,
-                                                          6, 6
-                                                          );
-                                                      particle->setBrush(QColor(255, 255, 200));
-                                                      particle->setPen(Qt::NoPen);
-                                                      particle->setZValue(1000);
-                                                      particle->setOpacity(1.0);
-                                                      scene->addItem(particle);
-
                                                       qreal angle = (i * 72) * M_PI / 180.0;
                                                       qreal dist = 50;
 
-                                                      QVariantAnimation *particleAnim = new QVariantAnimation(b);
-                                                      particleAnim->setDuration(350);
-                                                      particleAnim->setStartValue(0.0);
-                                                      particleAnim->setEndValue(1.0);
-
-                                                      QObject::connect(particleAnim, &QVariantAnimation::valueChanged,
-                                                                       [=](const QVariant &v) {
-                                                                           qreal t = v.toReal();
-                                                                           particle->setPos(
-                                                                               ballCenterX - 3 + std::cos(angle) * dist * t,
-                                                                               ballCenterY - 3 + std::sin(angle) * dist * t
-                                                                               );
-                                                                           particle->setOpacity(1.0 - t);
-                                                                       });
-
-                                                      QObject::connect(particleAnim, &QVariantAnimation::finished,
-                                                                       [=]() {
-                                                                           scene->removeItem(particle);
-                                                                           delete particle;
-                                                                       });
-
-                                                      QTimer::singleShot(i * 40, [=]() {
-                                                          particleAnim->start(QAbstractAnimation::DeleteWhenStopped);
-                                                      });
+                                                      EffectSpec particle;
+                                                      particle.center = QPointF(ballCenterX, ballCenterY);
+                                                      particle.travel = QPointF(std::cos(angle) * dist, std::sin(angle) * dist);
+                                                      particle.startSize = 6;
+                                                      particle.endSize = 6;
+                                                      particle.fill = QColor(255, 255, 200);
+                                                      particle.z = 1000;
+                                                      particle.durationMs = b->timeline.scaled(350);
+                                                      particle.delayMs = b->timeline.scaled(i * 40);
+                                                      b->effects.spawn(particle);
                                                   }
 
                                                   scene->removeItem(pokeball);
@@ -221,7 +170,6 @@ void Animations_BT::animateAttackImpact(BattleSequence *b, bool isPlayerAttackin
 {
     if (!b || !b->getScene()) return;
 
-    QGraphicsScene *scene = b->getScene();
     QGraphicsPixmapItem *attacker = isPlayerAttacking ? b->battlePlayerPokemonItem : b->battleEnemyItem;
     QGraphicsPixmapItem *target = isPlayerAttacking ? b->battleEnemyItem : b->battlePlayerPokemonItem;
 
@@ -231,7 +179,7 @@ void Animations_BT::animateAttackImpact(BattleSequence *b, bool isPlayerAttackin
     qreal lungeDistance = isPlayerAttacking ? 50 : -50;
 
     QVariantAnimation *lunge = new QVariantAnimation();
-    lunge->setDuration(100);
+    lunge->setDuration(b->timeline.scaled(100));
     lunge->setStartValue(originalX);
     lunge->setEndValue(originalX + lungeDistance);
     lunge->setEasingCurve(QEasingCurve::OutCubic);
@@ -246,118 +194,47 @@ void Animations_BT::animateAttackImpact(BattleSequence *b, bool isPlayerAttackin
                          qreal targetCenterX = target->x() + (target->boundingRect().width() * target->scale()) / 2;
                          qreal targetCenterY = target->y() + (target->boundingRect().height() * target->scale()) / 2;
 
-                         QGraphicsEllipseItem *impactRing = new QGraphicsEllipseItem(
-                             targetCenterX - 10,
-                             targetCenterY - 10,
-                             20, 20
-                             );
-                         impactRing->setBrush(Qt::NoBrush);
-                         impactRing->setPen(QPen(QColor(255, 200, 0), 4));
-                         impactRing->setZValue(999);
-                         impactRing->setOpacity(1.0);
-                         scene->addItem(impactRing);
-
-                         QVariantAnimation *ringAnim = new QVariantAnimation();
-                         ringAnim->setDuration(300);
-                         ringAnim->setStartValue(0.0);
-                         ringAnim->setEndValue(1.0);
-
-                         QObject::connect(ringAnim, &QVariantAnimation::valueChanged,
-                                          [=](const QVariant &v) {
-                                              qreal t = v.toReal();
-                                              qreal size = 20 + t * 80;
-                                              impactRing->setRect(
-                                                  targetCenterX - size/2,
-                                                  targetCenterY - size/2,
-                                                  size, size
-                                                  );
-                                              impactRing->setOpacity(1.0 - t);
-                                          });
-
-                         QObject::connect(ringAnim, &QVariantAnimation::finished,
-                                          [=]() {
-                                              scene->removeItem(impactRing);
-                                              delete impactRing;
-                                          });
-
-                         ringAnim->start(QAbstractAnimation::DeleteWhenStopped);
+                         EffectSpec ring;
+                         ring.center = QPointF(targetCenterX, targetCenterY);
+                         ring.startSize = 20;
+                         ring.endSize = 100;
+                         ring.fill = Qt::transparent;
+                         ring.outline = QColor(255, 200, 0);
+                         ring.outlineWidth = 4;
+                         ring.z = 999;
+                         ring.durationMs = b->timeline.scaled(300);
+                         b->effects.spawn(ring);
 
                          for (int i = 0; i < 8; ++i) {
-                             QGraphicsEllipseItem *spark = new QGraphicsEllipseItem(
-                                 targetCenterX - 4,
-                                 targetCenterY - 4,
-                                 8, 8
-                                 );
-                             spark->setBrush(QColor(255, 150, 50));
-                             spark->setPen(Qt::NoPen);
-                             spark->setZValue(998);
-                             spark->setOpacity(1.0);
-                             scene->addItem(spark);
-
                              qreal angle = (i * 45) * M_PI / 180.0;
                              qreal distance = 40 + QRandomGenerator::global()->bounded(30);
 
-                             QVariantAnimation *sparkAnim = new QVariantAnimation();
-                             sparkAnim->setDuration(300);
-                             sparkAnim->setStartValue(0.0);
-                             sparkAnim->setEndValue(1.0);
-
-                             QObject::connect(sparkAnim, &QVariantAnimation::valueChanged,
-                                              [=](const QVariant &v) {
-                                                  qreal t = v.toReal();
-                                                  spark->setPos(
-                                                      targetCenterX - 4 + std::cos(angle) * distance * t,
-                                                      targetCenterY - 4 + std::sin(angle) * distance * t
-                                                      );
-                                                  spark->setOpacity(1.0 - t);
-                                                  qreal scale = 1.0 + t * 0.5;
-                                                  spark->setScale(scale);
-                                              });
-
-                             QObject::connect(sparkAnim, &QVariantAnimation::finished,
-                                              [=]() {
-                                                  scene->removeItem(spark);
-                                                  delete spark;
-                                              });
-
-                             sparkAnim->start(QAbstractAnimation::DeleteWhenStopped);
+                             EffectSpec spark;
+                             spark.center = QPointF(targetCenterX, targetCenterY);
+                             spark.travel = QPointF(std::cos(angle) * distance, std::sin(angle) * distance);
+                             spark.startSize = 8;
+                             spark.endSize = 12;
+                             spark.fill = QColor(255, 150, 50);
+                             spark.z = 998;
+                             spark.durationMs = b->timeline.scaled(300);
+                             b->effects.spawn(spark);
                          }
 
-                         QGraphicsEllipseItem *coreFlash = new QGraphicsEllipseItem(
-                             targetCenterX - 30,
-                             targetCenterY - 30,
-                             60, 60
-                             );
-                         coreFlash->setBrush(Qt::white);
-                         coreFlash->setPen(Qt::NoPen);
-                         coreFlash->setZValue(1000);
-                         coreFlash->setOpacity(0.0);
-                         scene->addItem(coreFlash);
-
-                         QVariantAnimation *flashAnim = new QVariantAnimation();
-                         flashAnim->setDuration(200);
-                         flashAnim->setStartValue(0.0);
-                         flashAnim->setKeyValueAt(0.15, 1.0);
-                         flashAnim->setKeyValueAt(0.6, 0.6);
-                         flashAnim->setEndValue(0.0);
-
-                         QObject::connect(flashAnim, &QVariantAnimation::valueChanged,
-                                          [=](const QVariant &v) {
-                                              coreFlash->setOpacity(v.toReal());
-                                          });
-
-                         QObject::connect(flashAnim, &QVariantAnimation::finished,
-                                          [=]() {
-                                              scene->removeItem(coreFlash);
-                                              delete coreFlash;
-                                          });
-
-                         flashAnim->start(QAbstractAnimation::DeleteWhenStopped);
+                         EffectSpec coreFlash;
+                         coreFlash.center = QPointF(targetCenterX, targetCenterY);
+                         coreFlash.startSize = 60;
+                         coreFlash.endSize = 60;
+                         coreFlash.z = 1000;
+                         coreFlash.durationMs = b->timeline.scaled(200);
+                         coreFlash.peakAt = 0.15;
+                         coreFlash.holdAt = 0.6;
+                         coreFlash.holdLevel = 0.6;
+                         b->effects.spawn(coreFlash);
 
                          qreal targetOriginalX = target->x();
                          qreal targetOriginalY = target->y();
                          QVariantAnimation *shake = new QVariantAnimation();
-                         shake->setDuration(250);
+                         shake->setDuration(b->timeline.scaled(250));
                          shake->setStartValue(0);
                          shake->setKeyValueAt(0.15, 12);
                          shake->setKeyValueAt(0.3, -12);
@@ -382,7 +259,7 @@ void Animations_BT::animateAttackImpact(BattleSequence *b, bool isPlayerAttackin
                          shake->start(QAbstractAnimation::DeleteWhenStopped);
 
                          QVariantAnimation *returnAnim = new QVariantAnimation();
-                         returnAnim->setDuration(100);
+                         returnAnim->setDuration(b->timeline.scaled(100));
                          returnAnim->setStartValue(attacker->x());
                          returnAnim->setEndValue(originalX);
                          returnAnim->setEasingCurve(QEasingCurve::InCubic);
@@ -417,7 +294,7 @@ void Animations_BT::battleZoomReveal(BattleSequence *b)
     full.addRect(0, 0, 480, 272);
 
     QVariantAnimation *anim = new QVariantAnimation();
-    anim->setDuration(2000);
+    anim->setDuration(b->timeline.scaled(2000));
     anim->setStartValue(0);
     anim->setEndValue(1100);
     anim->setEasingCurve(QEasingCurve::OutCubic);
@@ -464,7 +341,7 @@ void Animations_BT::animateBattleEntrances(BattleSequence *b)
     full.addRect(0, 0, 480, 272);
 
     QVariantAnimation *circle = new QVariantAnimation();
-    circle->setDuration(900);
+    circle->setDuration(b->timeline.scaled(900));
     circle->setStartValue(0.0);
     circle->setEndValue(450.0);
     circle->setEasingCurve(QEasingCurve::OutCubic);
@@ -511,7 +388,7 @@ void Animations_BT::animateBattleEntrances(BattleSequence *b)
 
     // Player slide
     QVariantAnimation *playerSlide = new QVariantAnimation();
-    playerSlide->setDuration(750);
+    playerSlide->setDuration(b->timeline.scaled(750));
     playerSlide->setStartValue(playerFinal.x() - 500);
     playerSlide->setEndValue(playerFinal.x());
     playerSlide->setEasingCurve(QEasingCurve::OutBack);
@@ -525,7 +402,7 @@ void Animations_BT::animateBattleEntrances(BattleSequence *b)
 
     // Enemy slide
     QVariantAnimation *enemySlide = new QVariantAnimation();
-    enemySlide->setDuration(750);
+    enemySlide->setDuration(b->timeline.scaled(750));
     enemySlide->setStartValue(b->battleEnemyItem->x());
     enemySlide->setEndValue(enemyFinal.x());
     enemySlide->setEasingCurve(QEasingCurve::OutBack);
@@ -537,7 +414,7 @@ void Animations_BT::animateBattleEntrances(BattleSequence *b)
                      });
 
     // Start both after a tiny delay (feels nicer)
-    QTimer::singleShot(100, [=]()
+    QTimer::singleShot(b->timeline.scaled(100), [=]()
                        {
                            playerSlide->start(QAbstractAnimation::DeleteWhenStopped);
                            enemySlide->start(QAbstractAnimation::DeleteWhenStopped);
@@ -555,7 +432,7 @@ void Animations_BT::slideInCommandMenu(BattleSequence *b)
     int py[4] = {18, 18, 42, 42};
 
     QVariantAnimation *anim = new QVariantAnimation();
-    anim->setDuration(250);
+    anim->setDuration(b->timeline.scaled(250));
     anim->setStartValue(300);
     anim->setEndValue(b->commandBoxSprite->pos().y());
     anim->setEasingCurve(QEasingCurve::OutCubic);
@@ -591,7 +468,7 @@ void Animations_BT::slideOutCommandMenu(BattleSequence *b, std::function<void()>
     int py[4] = {18,18,42,42};
 
     QVariantAnimation *anim = new QVariantAnimation();
-    anim->setDuration(200);
+    anim->setDuration(b->timeline.scaled(200));
     anim->setStartValue(b->commandBoxSprite->pos().y());
     anim->setEndValue(300);
     anim->setEasingCurve(QEasingCurve::InCubic);
@@ -629,7 +506,7 @@ void Animations_BT::animateMenuSelection(BattleSequence *b, int index)
     int targetY = b->battleMenuOptions[index]->pos().y() - 5;
 
     QVariantAnimation *anim = new QVariantAnimation();
-    anim->setDuration(80);
+    anim->setDuration(b->timeline.scaled(80));
     anim->setStartValue(targetY);
     anim->setKeyValueAt(0.4, targetY - 3);
     anim->setEndValue(targetY);
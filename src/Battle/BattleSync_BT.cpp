@@ -0,0 +1,226 @@
+#include "BattleSync_BT.h"
+#include <QStringList>
+#include <QMap>
+#include <QPair>
+#include <QVector>
+
+namespace {
+
+struct TeamEntry {
+    int dex = 0;
+    int level = 0;
+    int damage = 0;
+    QVector<int> ppUsed;
+    bool active = false;
+};
+
+QString encodeEntry(const Pokemon &pokemon, bool active)
+{
+    QString entry = QString("%1%2.%3.%4")
+                        .arg(active ? "@" : "")
+                        .arg(pokemon.getDexNumber())
+                        .arg(pokemon.getLevel())
+                        .arg(pokemon.getMaxHP() - pokemon.getCurrentHP());
+
+    // PP spent per move, trailing zeros dropped
+    QStringList pp;
+    const auto &moves = pokemon.getMoves();
+    for (const Attack &move : moves) {
+        pp << QString::number(move.getMaxPP() - move.getCurrentPP());
+    }
+    while (!pp.isEmpty() && pp.last() == "0") {
+        pp.removeLast();
+    }
+    if (!pp.isEmpty()) {
+        entry += "." + pp.join('/');
+    }
+    return entry;
+}
+
+bool decodeEntry(const QString &text, TeamEntry *entry)
+{
+    QString body = text;
+    entry->active = body.startsWith('@');
+    if (entry->active) {
+        body.remove(0, 1);
+    }
+
+    QStringList fields = body.split('.');
+    if (fields.size() < 3) return false;
+
+    bool okDex = false, okLvl = false, okDmg = false;
+    entry->dex = fields[0].toInt(&okDex);
+    entry->level = fields[1].toInt(&okLvl);
+    entry->damage = fields[2].toInt(&okDmg);
+    if (!okDex || !okLvl || !okDmg || entry->dex <= 0 || entry->level <= 0 || entry->damage < 0) {
+        return false;
+    }
+
+    entry->ppUsed.clear();
+    if (fields.size() >= 4) {
+        for (const QString &pp : fields[3].split('/')) {
+            entry->ppUsed.append(qMax(0, pp.toInt()));
+        }
+    }
+    return true;
+}
+
+void applyEntry(Pokemon &pokemon, const TeamEntry &entry)
+{
+    // heal() clears the fainted flag, takeDamage() sets it again at 0 HP
+    pokemon.heal(pokemon.getMaxHP());
+    if (entry.damage > 0) {
+        pokemon.takeDamage(entry.damage);
+    }
+
+    auto &moves = pokemon.getMoves();
+    for (size_t i = 0; i < moves.size(); ++i) {
+        Attack &move = moves[i];
+        move.restorePP(move.getMaxPP());
+        int used = i < static_cast<size_t>(entry.ppUsed.size()) ? entry.ppUsed[static_cast<int>(i)] : 0;
+        for (int n = 0; n < used; ++n) {
+            move.use();
+        }
+    }
+}
+
+} // namespace
+
+QString BattleSync_BT::encodeSummary(const Summary &summary)
+{
+    return QString("%1,%2,%3,%4,%5")
+        .arg(summary.turn)
+        .arg(summary.senderHasTurn ? 1 : 0)
+        .arg(summary.ownHash, 8, 16, QChar('0'))
+        .arg(summary.enemyHash, 8, 16, QChar('0'))
+        .arg(static_cast<int>(summary.kind));
+}
+
+bool BattleSync_BT::decodeSummary(const QString &data, Summary *summary)
+{
+    QStringList parts = data.split(',');
+    if (parts.size() < 5) return false;
+
+    bool ok[5] = {false, false, false, false, false};
+    summary->turn = parts[0].toInt(&ok[0]);
+    summary->senderHasTurn = parts[1].toInt(&ok[1]) != 0;
+    summary->ownHash = parts[2].toUInt(&ok[2], 16);
+    summary->enemyHash = parts[3].toUInt(&ok[3], 16);
+    int kind = parts[4].toInt(&ok[4]);
+    if (!ok[0] || !ok[1] || !ok[2] || !ok[3] || !ok[4] || kind < 0 || kind > 2) {
+        return false;
+    }
+    summary->kind = static_cast<SummaryKind>(kind);
+    return true;
+}
+
+QString BattleSync_BT::encodeTeam(const Player &player)
+{
+    const auto &team = player.getTeam();
+    const Pokemon *active = player.getActivePokemon();
+
+    // One entry per species/level. The opponent's mirror of our team can hold
+    // duplicates (SWITCH back to an earlier Pokemon adds a fresh copy), so the
+    // active copy wins, otherwise the most recent one.
+    QMap<QPair<int, int>, QString> entries;
+    for (const Pokemon &pokemon : team) {
+        const bool isActive = &pokemon == active;
+        const QPair<int, int> key(pokemon.getDexNumber(), pokemon.getLevel());
+        if (!isActive && entries.value(key).startsWith('@')) continue;
+
+        // Fainted Pokemon stay in: a faint one board missed is exactly the
+        // kind of difference a resync has to find and repair
+        QString entry = encodeEntry(pokemon, isActive);
+        const bool untouched = entry.count('.') == 2 && entry.endsWith(".0");
+        if (!isActive && untouched) {
+            entries.remove(key);
+            continue;
+        }
+        entries.insert(key, entry);
+    }
+
+    // QMap iterates in dex/level order, which keeps the text canonical
+    return QStringList(entries.values()).join(',');
+}
+
+quint32 BattleSync_BT::hashTeam(const Player &player)
+{
+    const QByteArray bytes = encodeTeam(player).toUtf8();
+    quint32 hash = 2166136261u;
+    for (char c : bytes) {
+        hash ^= static_cast<quint8>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool BattleSync_BT::applyTeam(Player &player, const QString &encoded, bool addMissing)
+{
+    QVector<TeamEntry> entries;
+    for (const QString &text : encoded.split(',')) {
+        if (text.isEmpty()) continue;
+        TeamEntry entry;
+        if (!decodeEntry(text, &entry)) return false;
+        entries.append(entry);
+    }
+
+    int activeIndex = -1;
+    for (const TeamEntry &entry : entries) {
+        auto &team = player.getTeam();
+        const Pokemon *active = player.getActivePokemon();
+
+        // Prefer the active copy for the active entry, else the latest match
+        int match = -1;
+        for (int i = 0; i < static_cast<int>(team.size()); ++i) {
+            const Pokemon &pokemon = team[i];
+            if (pokemon.getDexNumber() != entry.dex || pokemon.getLevel() != entry.level) continue;
+            match = i;
+            if (entry.active && &pokemon == active) break;
+        }
+
+        if (match < 0) {
+            if (!addMissing) continue;
+            player.addPokemon(Pokemon(entry.dex, entry.level));
+            match = static_cast<int>(player.getTeam().size()) - 1;
+        }
+
+        applyEntry(player.getTeam()[match], entry);
+        if (entry.active) {
+            activeIndex = match;
+        }
+    }
+
+    if (activeIndex >= 0 && activeIndex != player.getActivePokemonIndex()) {
+        player.switchPokemon(activeIndex);
+    }
+    return true;
+}
+
+QString BattleSync_BT::encodeState(int turn, bool senderHasTurn, const Player &own, const Player &enemy)
+{
+    return QString("%1;%2;%3;%4")
+        .arg(turn)
+        .arg(senderHasTurn ? 1 : 0)
+        .arg(encodeTeam(own))
+        .arg(encodeTeam(enemy));
+}
+
+bool BattleSync_BT::applyState(const QString &data, Player &own, Player &enemy,
+                               int *turn, bool *receiverHasTurn)
+{
+    QStringList parts = data.split(';');
+    if (parts.size() < 4) return false;
+
+    bool okTurn = false, okFlag = false;
+    int newTurn = parts[0].toInt(&okTurn);
+    bool senderHasTurn = parts[1].toInt(&okFlag) != 0;
+    if (!okTurn || !okFlag) return false;
+
+    // The sender's own team is our enemy; its view of us is our own team
+    if (!applyTeam(enemy, parts[2], true)) return false;
+    if (!applyTeam(own, parts[3], false)) return false;
+
+    if (turn) *turn = newTurn;
+    if (receiverHasTurn) *receiverHasTurn = !senderHasTurn;
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef BATTLESYNC_BT_H
+#define BATTLESYNC_BT_H
+
+#include <QString>
+#include "Battle_logic/Player.h"
+
+// PvP state recovery helpers. When a link blip loses a TURN/ITEM/SWITCH
+// packet, both boards end up waiting on each other. BattleSequence then
+// swaps a RESYNC_HASH summary; if the hashes disagree, the side that has
+// seen more turns sends RESYNC_STATE and the other side adopts it.
+//
+// Teams are encoded relative to the battle start (full HP and PP), so only
+// Pokemon that have taken damage or spent PP are listed, plus the active one
+// (marked with '@'). A fainted Pokemon is listed with its full HP as damage:
+//   "@25.12.8.3/1,16.9.20"  ->  Pikachu L12 is active, 8 HP down, 3 PP used on
+//                               move 0 and 1 on move 1; Pidgey L9 is 20 HP down
+class BattleSync_BT
+{
+public:
+    // Summary sent first: "turn,hasTurn,ownHash,enemyHash,kind"
+    enum class SummaryKind {
+        Request = 0,    // Sender is stuck waiting; please compare
+        InSync = 1,     // Hashes and turn agree, nothing to do
+        NeedState = 2   // Receiver should send RESYNC_STATE
+    };
+
+    struct Summary {
+        int turn = 0;
+        bool senderHasTurn = false;
+        quint32 ownHash = 0;     // Sender's team as the sender sees it
+        quint32 enemyHash = 0;   // Receiver's team as the sender sees it
+        SummaryKind kind = SummaryKind::Request;
+    };
+
+    static QString encodeSummary(const Summary &summary);
+    static bool decodeSummary(const QString &data, Summary *summary);
+
+    // Delta-encoded team (see above). Untouched benched Pokemon are left out,
+    // so both boards produce the same text for the same battle.
+    static QString encodeTeam(const Player &player);
+
+    // FNV-1a over encodeTeam()
+    static quint32 hashTeam(const Player &player);
+
+    // Apply an encoded team; entries at full damage faint their Pokemon.
+    // Pokemon not listed are left as they are. When addMissing is set, listed
+    // Pokemon the player doesn't have are created (used for the opponent's
+    // side, which we only know from SWITCH packets).
+    static bool applyTeam(Player &player, const QString &encoded, bool addMissing);
+
+    // Full state: "turn;senderHasTurn;senderTeam;receiverTeam"
+    static QString encodeState(int turn, bool senderHasTurn, const Player &own, const Player &enemy);
+
+    // Apply a RESYNC_STATE from the receiver's point of view
+    static bool applyState(const QString &data, Player &own, Player &enemy,
+                           int *turn, bool *receiverHasTurn);
+};
+
+#endif // BATTLESYNC_BT_H
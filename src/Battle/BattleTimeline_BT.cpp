@@ -0,0 +1,187 @@
+#include "BattleTimeline_BT.h"
+#include "../General/frame_profiler.h"
+#include <QDebug>
+
+BattleTimeline_BT::BattleTimeline_BT(QObject *parent)
+    : QObject(parent)
+{
+    clock.start();
+
+    currentSpeed = speedFromEnvironment();
+}
+
+int BattleTimeline_BT::speedFromEnvironment()
+{
+    const QString value = qEnvironmentVariable("POKELITE_BATTLE_SPEED").trimmed().toLower();
+    if (value.isEmpty()) return 1;
+    if (value == "instant" || value == "0") return 0;
+
+    bool ok = false;
+    const int speed = value.toInt(&ok);
+    if (ok && (speed == 1 || speed == 2 || speed == 4)) return speed;
+
+    qDebug() << "Ignoring POKELITE_BATTLE_SPEED" << value << "- use 1, 2, 4 or instant";
+    return 1;
+}
+
+void BattleTimeline_BT::wait(int ms)
+{
+    Step step;
+    step.waitMs = qMax(0, ms);
+    enqueue(step);
+}
+
+void BattleTimeline_BT::call(const Action &action)
+{
+    if (!action) return;
+
+    Step step;
+    step.action = action;
+    enqueue(step);
+}
+
+void BattleTimeline_BT::waitFor(const Hold &start)
+{
+    if (!start) return;
+
+    Step step;
+    step.hold = start;
+    enqueue(step);
+}
+
+void BattleTimeline_BT::enqueue(Step step)
+{
+    if (insertAt >= 0) {
+        steps.insert(insertAt++, step);
+        return;  // The running call's advance() picks it up
+    }
+
+    steps.append(step);
+    advance();
+}
+
+void BattleTimeline_BT::clear()
+{
+    steps.clear();
+    holding = false;
+    ++holdToken;
+    if (insertAt >= 0) {
+        insertAt = 0;
+    }
+}
+
+void BattleTimeline_BT::skipWait()
+{
+    if (holding || steps.isEmpty() || !steps.first().isWait()) return;
+
+    steps.removeFirst();
+    advance();
+}
+
+void BattleTimeline_BT::setFastForward(bool on)
+{
+    if (fastForward == on) return;
+
+    fastForward = on;
+    qDebug() << "Battle fast-forward" << (on ? "on" : "off");
+    advance();
+}
+
+void BattleTimeline_BT::setSpeed(int speed)
+{
+    if (speed != 0 && speed != 1 && speed != 2 && speed != 4) return;
+    if (currentSpeed == speed) return;
+
+    currentSpeed = speed;
+    qDebug() << "Battle speed" << (speed ? QString("%1x").arg(speed) : QString("instant"));
+    advance();
+}
+
+void BattleTimeline_BT::cycleSpeed()
+{
+    switch (currentSpeed) {
+    case 1:  setSpeed(2); break;
+    case 2:  setSpeed(4); break;
+    case 4:  setSpeed(0); break;
+    default: setSpeed(1); break;
+    }
+}
+
+int BattleTimeline_BT::scaled(int ms) const
+{
+    if (isInstant()) return 0;
+    return ms / currentSpeed;
+}
+
+int BattleTimeline_BT::pendingMs() const
+{
+    if (isInstant()) return 0;
+
+    const qint64 now = clock.elapsed();
+    qint64 total = 0;
+    for (const Step &step : steps) {
+        if (!step.isWait()) continue;
+        qint64 left = scaled(step.waitMs);
+        if (step.startMs >= 0) {
+            left -= now - step.startMs;
+        }
+        total += qMax<qint64>(0, left);
+    }
+    return int(total);
+}
+
+void BattleTimeline_BT::release(int token)
+{
+    if (!holding || token != holdToken) return;
+
+    holding = false;
+    advance();
+}
+
+void BattleTimeline_BT::advance()
+{
+    // A call that skips or clears ends up back here; the outer loop carries on
+    if (advancing) return;
+    advancing = true;
+    PROFILE_ZONE("battle.timeline");
+
+    while (!holding && !steps.isEmpty()) {
+        Step &head = steps.first();
+
+        if (head.isWait()) {
+            // Scaled here rather than when queued, so a speed change applies
+            // to the wait already counting down
+            const int waitMs = scaled(head.waitMs);
+            if (waitMs > 0) {
+                const qint64 now = clock.elapsed();
+                if (head.startMs < 0) {
+                    head.startMs = now;
+                }
+                if (now - head.startMs < waitMs) {
+                    break;
+                }
+            }
+            steps.removeFirst();
+            continue;
+        }
+
+        const Step step = steps.takeFirst();
+
+        insertAt = 0;
+        if (step.hold) {
+            holding = true;
+            const int token = ++holdToken;
+            step.hold([this, token]() { release(token); });
+        } else {
+            step.action();
+        }
+        insertAt = -1;
+    }
+
+    advancing = false;
+
+    // Nothing to poll while holding; done() restarts the queue
+    if (needsFrames()) {
+        emit framesNeeded();
+    }
+}
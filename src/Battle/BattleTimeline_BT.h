@@ -0,0 +1,97 @@
+#ifndef BATTLETIMELINE_BT_H
+#define BATTLETIMELINE_BT_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <functional>
+
+// Queue of battle steps (waits, calls and holds) run in order from the
+// battle's frame tick. This replaces the chains of nested QTimer::singleShot
+// lambdas, so a whole turn is one queue that can be cleared, skipped or
+// fast-forwarded. The owner calls tick() every frame while needsFrames().
+//
+// Steps queued from inside a running call go straight after it, in the
+// order they were queued, so nesting reads like the old singleShot chains.
+// Steps queued from anywhere else go at the back.
+class BattleTimeline_BT : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Action = std::function<void()>;
+    using Hold = std::function<void(Action done)>;
+
+    explicit BattleTimeline_BT(QObject *parent = nullptr);
+
+    void wait(int ms);
+    void call(const Action &action);
+    void after(int ms, const Action &action) { wait(ms); call(action); }
+
+    // Start something that finishes later (an HP bar drain, say) and hold
+    // the queue until it calls done. Late calls after clear() are ignored.
+    void waitFor(const Hold &start);
+
+    // Drop everything still queued, e.g. when the battle closes
+    void clear();
+
+    // End the wait that is counting down now (A/Enter during a message)
+    void skipWait();
+
+    // Waits take no time while on; calls still run in order
+    void setFastForward(bool on);
+    bool isFastForward() const { return fastForward; }
+
+    // Battle speed: 1, 2 or 4 times normal, or 0 for instant. Starts from
+    // POKELITE_BATTLE_SPEED (1, 2, 4 or "instant"); the default is 1.
+    void setSpeed(int speed);
+    int speed() const { return currentSpeed; }
+    void cycleSpeed();  // 1x -> 2x -> 4x -> instant -> 1x
+
+    // A duration in ms at the current speed; 0 when instant or fast-forwarding.
+    // Text reveal, HP bars, Animations_BT and the battle effects all use this.
+    int scaled(int ms) const;
+    bool isInstant() const { return fastForward || currentSpeed == 0; }
+
+    bool isIdle() const { return steps.isEmpty() && !holding; }
+
+    // A wait is counting down (nothing to poll while holding)
+    bool needsFrames() const { return !steps.isEmpty() && !holding; }
+    void tick() { advance(); }
+
+    // Time left before the queue is empty, at the current settings
+    int pendingMs() const;
+
+    // The clock waits are measured on, for other steps paced by the frame tick
+    qint64 now() const { return clock.elapsed(); }
+
+signals:
+    // A wait is queued; the owner should start calling tick()
+    void framesNeeded();
+
+private:
+    struct Step {
+        int waitMs = 0;         // At 1x; a wait has no action and no hold
+        Action action;
+        Hold hold;
+        qint64 startMs = -1;    // When the wait reached the front
+
+        bool isWait() const { return !action && !hold; }
+    };
+
+    QList<Step> steps;
+    QElapsedTimer clock;
+    bool fastForward = false;
+    int currentSpeed = 1;
+    bool advancing = false;
+    int insertAt = -1;          // >= 0 while a call runs
+    bool holding = false;
+    int holdToken = 0;          // Matches the done() that may release the hold
+
+    static int speedFromEnvironment();
+    void enqueue(Step step);
+    void release(int token);
+    void advance();
+};
+
+#endif // BATTLETIMELINE_BT_H
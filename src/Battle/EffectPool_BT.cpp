@@ -0,0 +1,102 @@
+#include "EffectPool_BT.h"
+#include <QGraphicsScene>
+#include <QGraphicsEllipseItem>
+#include <QBrush>
+#include <QPen>
+#include <QDebug>
+
+EffectPool_BT::EffectPool_BT(QObject *parent)
+    : QObject(parent)
+{
+    clock.start();
+}
+
+void EffectPool_BT::attach(QGraphicsScene *scene, int capacity)
+{
+    if (!scene || !effects.isEmpty()) return;
+
+    effects.resize(capacity);
+    for (Effect &effect : effects) {
+        // Owned by the scene, which outlives every battle
+        effect.item = new QGraphicsEllipseItem();
+        effect.item->setVisible(false);
+        scene->addItem(effect.item);
+    }
+}
+
+bool EffectPool_BT::spawn(const EffectSpec &spec)
+{
+    for (Effect &effect : effects) {
+        if (effect.live) continue;
+
+        effect.spec = spec;
+        effect.startMs = clock.elapsed();
+        effect.live = true;
+        ++active;
+
+        QGraphicsEllipseItem *item = effect.item;
+        item->setBrush(spec.fill.alpha() ? QBrush(spec.fill) : QBrush(Qt::NoBrush));
+        item->setPen(spec.outlineWidth > 0 ? QPen(spec.outline, spec.outlineWidth) : QPen(Qt::NoPen));
+        item->setZValue(spec.z);
+        item->setPos(0, 0);
+        item->setVisible(false);  // First frame places and shows it
+
+        emit framesNeeded();
+        return true;
+    }
+
+    qDebug() << "Effect pool full," << effects.size() << "effects already running";
+    return false;
+}
+
+void EffectPool_BT::clear()
+{
+    for (Effect &effect : effects) {
+        if (effect.live) release(effect);
+    }
+}
+
+void EffectPool_BT::release(Effect &effect)
+{
+    effect.live = false;
+    effect.item->setVisible(false);
+    --active;
+}
+
+qreal EffectPool_BT::opacityAt(const EffectSpec &spec, qreal t)
+{
+    if (t < spec.peakAt) {
+        return t / spec.peakAt;
+    }
+    if (t < spec.holdAt) {
+        return 1.0 + (spec.holdLevel - 1.0) * (t - spec.peakAt) / (spec.holdAt - spec.peakAt);
+    }
+    const qreal from = qMax(spec.peakAt, spec.holdAt);
+    const qreal level = spec.holdAt > spec.peakAt ? spec.holdLevel : 1.0;
+    return from >= 1.0 ? 0.0 : level * (1.0 - (t - from) / (1.0 - from));
+}
+
+void EffectPool_BT::tick()
+{
+    const qint64 now = clock.elapsed();
+
+    for (Effect &effect : effects) {
+        if (!effect.live) continue;
+
+        const EffectSpec &spec = effect.spec;
+        const qint64 age = now - effect.startMs - spec.delayMs;
+        if (age < 0) continue;
+
+        const qreal t = spec.durationMs > 0 ? qreal(age) / spec.durationMs : 1.0;
+        if (t >= 1.0) {
+            release(effect);
+            continue;
+        }
+
+        const qreal size = spec.startSize + (spec.endSize - spec.startSize) * t;
+        const QPointF c = spec.center + spec.travel * t;
+        effect.item->setRect(c.x() - size / 2, c.y() - size / 2, size, size);
+        effect.item->setOpacity(spec.strength * opacityAt(spec, t));
+        effect.item->setVisible(true);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef EFFECTPOOL_BT_H
+#define EFFECTPOOL_BT_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QColor>
+#include <QPointF>
+
+class QGraphicsScene;
+class QGraphicsEllipseItem;
+
+// One short-lived circle: a flash, ring, spark or particle
+struct EffectSpec {
+    QPointF center;              // Centre when the effect starts
+    QPointF travel;              // How far the centre moves over the lifetime
+    qreal startSize = 8;         // Diameter at the start...
+    qreal endSize = 8;           // ...and at the end
+    QColor fill = Qt::white;     // Qt::transparent for rings
+    QColor outline = Qt::transparent;
+    qreal outlineWidth = 0;
+    qreal z = 999;
+    int durationMs = 300;
+    int delayMs = 0;             // Stay hidden this long before starting
+
+    // Opacity is piecewise linear through (0, peakAt > 0 ? 0 : 1),
+    // (peakAt, 1), (holdAt, holdLevel) and (1, 0). The defaults fade out.
+    qreal peakAt = 0;
+    qreal holdAt = 0;
+    qreal holdLevel = 1;
+    qreal strength = 1;          // Scales the whole opacity curve
+};
+
+// Fixed set of ellipse items, created once with the battle scene, that every
+// hit flash, impact ring and particle borrows. The battle's frame tick moves
+// all live effects through tick() while any are left. That replaces a new
+// item plus a QVariantAnimation per particle.
+class EffectPool_BT : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EffectPool_BT(QObject *parent = nullptr);
+
+    // Create the items in the scene (hidden). Call once.
+    void attach(QGraphicsScene *scene, int capacity = kDefaultCapacity);
+
+    // Returns false (and shows nothing) if every item is busy
+    bool spawn(const EffectSpec &spec);
+
+    // Hide everything, e.g. when a new battle starts
+    void clear();
+
+    int activeCount() const { return active; }
+    int capacity() const { return effects.size(); }
+
+    bool needsFrames() const { return active > 0; }
+    void tick();
+
+signals:
+    // An effect started; the owner should start calling tick()
+    void framesNeeded();
+
+private:
+    struct Effect {
+        QGraphicsEllipseItem *item = nullptr;
+        EffectSpec spec;
+        qint64 startMs = 0;
+        bool live = false;
+    };
+
+    static constexpr int kDefaultCapacity = 32;
+
+    QVector<Effect> effects;
+    int active = 0;
+    QElapsedTimer clock;
+
+    static qreal opacityAt(const EffectSpec &spec, qreal t);
+    void release(Effect &effect);
+};
+
+#endif // EFFECTPOOL_BT_H
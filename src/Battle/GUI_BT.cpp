@@ -2,6 +2,9 @@
 #include "Battle_logic/PokemonData.h"
 #include "Battle_logic/Item.h"
 #include "../General/uart_comm.h"
+#include "BattleSync_BT.h"
+#include "../General/sprite_cache.h"
+#include "../General/frame_profiler.h"
 #include <QDebug>
 #include <QBrush>
 #include <QPen>
@@ -13,21 +16,21 @@
 #include <cmath>
 
 
-BattleSequence::BattleSequence(QGraphicsScene *scene, QGraphicsView *view)
-    : QObject(nullptr), battleScene(scene), view(view), animations(this)
+BattleSequence::BattleSequence(QGraphicsView *view)
+    : QObject(nullptr), battleScene(nullptr), view(view), animations(this)
 {
-    connect(&battleTextTimer, &QTimer::timeout, this, [this]() {
-        if (!battleTextItem) {
-            battleTextTimer.stop();
-            return;
-        }
-        if (battleTextIndex >= fullBattleText.size()) {
-            battleTextTimer.stop();
-            return;
-        }
-        battleTextIndex++;
-        battleTextItem->setPlainText(fullBattleText.left(battleTextIndex));
-    });
+    resyncWatchdog.setInterval(1000);
+    connect(&resyncWatchdog, &QTimer::timeout, this, &BattleSequence::checkResyncWatchdog);
+
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    frameTimer.setInterval(16);
+    connect(&frameTimer, &QTimer::timeout, this, &BattleSequence::onFrame);
+    connect(&timeline, &BattleTimeline_BT::framesNeeded, this, &BattleSequence::startFrames);
+    connect(&effects, &EffectPool_BT::framesNeeded, this, &BattleSequence::startFrames);
+    connect(&playerHpBar, &HpBar_BT::framesNeeded, this, &BattleSequence::startFrames);
+    connect(&enemyHpBar, &HpBar_BT::framesNeeded, this, &BattleSequence::startFrames);
+
+    buildBattleScene();
 }
 
 
@@ -36,6 +39,47 @@ BattleSequence::~BattleSequence()
     closeBattle();
 }
 
+void BattleSequence::startFrames()
+{
+    if (!frameTimer.isActive()) {
+        frameTimer.start();
+    }
+}
+
+void BattleSequence::onFrame()
+{
+    PROFILE_ZONE("battle.frame");
+
+    // Bars first: one that stops can release the timeline in the same frame
+    playerHpBar.tick();
+    enemyHpBar.tick();
+    effects.tick();
+    tickText();
+    timeline.tick();
+
+    if (!timeline.needsFrames() && !effects.needsFrames() && textStartMs < 0
+        && !playerHpBar.isAnimating() && !enemyHpBar.isAnimating()) {
+        frameTimer.stop();
+    }
+}
+
+void BattleSequence::tickText()
+{
+    if (textStartMs < 0) return;
+
+    // Show whichever characters are due, so a late frame catches up
+    const int due = qMin<qint64>(fullBattleText.size(), (timeline.now() - textStartMs) / textStepMs);
+    if (due > battleTextIndex) {
+        battleTextIndex = due;
+        if (battleTextItem) {
+            battleTextItem->setVisibleCount(battleTextIndex);
+        }
+    }
+    if (battleTextIndex >= fullBattleText.size()) {
+        textStartMs = -1;
+    }
+}
+
 QString BattleSequence::capitalizeFirst(const QString& str) const
 {
     if (str.isEmpty()) return str;
@@ -44,13 +88,6 @@ QString BattleSequence::capitalizeFirst(const QString& str) const
 
 void BattleSequence::startBattle(Player* player, Player* enemy, BattleSystem* bs)
 {
-    // Clean up any existing battle scene first
-    if (battleScene) {
-        battleScene->clear();
-        delete battleScene;
-        battleScene = nullptr;
-    }
-
     gamePlayer = player;
     enemyPlayer = enemy;
     battleSystem = bs;
@@ -71,130 +108,31 @@ void BattleSequence::startBattle(Player* player, Player* enemy, BattleSystem* bs
     opponentTurnComplete = false;
     isMyTurn = false; // Will be set by determineInitialTurnOrder or setInitialTurnOrder for PvP
     hasReceivedTurnOrder = false; // Will be set when TURN_ORDER packet is received (PvP only)
+    turnNumber = 0;
 
-    // Don't determine turn order here - it will be set by:
-    // - Initiator: determines and sends TURN_ORDER packet, then calls setInitialTurnOrder
-    // - Responder: waits for TURN_ORDER packet, then calls setInitialTurnOrder
-
-    // Clean any leftover menus
-    destroyMoveMenu();
-    destroyBagMenu();
-    destroyPokemonMenu();
-
-    // New battle scene
-    battleScene = new QGraphicsScene(0, 0, 480, 272, nullptr);
-
-    // Background
-    QPixmap battleBg(":/assets/battle/battle_bg.png");
-    if (battleBg.isNull()) {
-        battleBg = QPixmap(480, 272);
-        battleBg.fill(Qt::black);
-        QGraphicsPixmapItem* bgItem = battleScene->addPixmap(battleBg);
-        bgItem->setZValue(0);
+    // Watch for a stalled PvP exchange (lost packet, cable blip)
+    waitingSince.invalidate();
+    lastOpponentActivity.start();
+    resyncTimeoutMs = 6000 + QRandomGenerator::global()->bounded(3000);
+    if (battleSystem && battleSystem->getPvpMode()) {
+        resyncWatchdog.start();
     } else {
-        QGraphicsPixmapItem* bgItem = battleScene->addPixmap(battleBg);
-        qreal scaleX = 480.0 / battleBg.width();
-        qreal scaleY = 200.0 / battleBg.height();
-        qreal scale = std::max(scaleX, scaleY);
-        bgItem->setScale(scale);
-
-        qreal scaledHeight = battleBg.height() * scale;
-        qreal yOffset = 200 - scaledHeight;
-        bgItem->setPos(0, yOffset);
-        bgItem->setZValue(0);
-    }
-
-    QGraphicsRectItem* bottomBg = new QGraphicsRectItem(0, 200, 480, 72);
-    bottomBg->setBrush(Qt::black);
-    bottomBg->setPen(Qt::NoPen);
-    bottomBg->setZValue(1);
-    battleScene->addItem(bottomBg);
-
-    // Player trainer sprite
-    QPixmap trainerPx(":/assets/battle/trainer.png");
-    if (!trainerPx.isNull()) {
-        float sx = 130.0f / trainerPx.width();
-        float sy = 130.0f / trainerPx.height();
-        float scale = std::min(sx, sy);
-
-        battleTrainerItem = battleScene->addPixmap(trainerPx);
-        battleTrainerItem->setScale(scale);
-
-        qreal h = trainerPx.height() * scale;
-        battleTrainerItem->setPos(20, 272 - h - 70);
-        battleTrainerItem->setZValue(0);
+        resyncWatchdog.stop();
     }
 
-    // Player's Pokemon sprite
-    const Pokemon* playerPokemon = gamePlayer->getActivePokemon();
-    if (playerPokemon) {
-        QString playerSpritePath = QString::fromStdString(playerPokemon->getBackSpritePath());
-        QPixmap playerPx(playerSpritePath);
-        if (playerPx.isNull()) {
-            QString spriteDir = QString::fromStdString(playerPokemon->getSpriteDir());
-            playerSpritePath = ":/" + spriteDir + "/back.png";
-            playerPx = QPixmap(playerSpritePath);
-        }
-        if (playerPx.isNull()) {
-            playerPx = QPixmap(":/Battle/assets/pokemon_sprites/006_charizard/back.png");
-        }
-        if (!playerPx.isNull()) {
-            float sx = 140.0f / playerPx.width();
-            float sy = 140.0f / playerPx.height();
-            float scale = std::min(sx, sy);
-
-            battlePlayerPokemonItem = battleScene->addPixmap(playerPx);
-            battlePlayerPokemonItem->setScale(scale);
-
-            qreal h = playerPx.height() * scale;
-            battlePlayerPokemonItem->setPos(60, 272 - h - 50);
-            battlePlayerPokemonItem->setZValue(2);
-
-            // Hide until throw animation finishes
-            battlePlayerPokemonItem->setVisible(false);
-        }
-    }
+    // Don't determine turn order here - it will be set by:
+    // - Initiator: determines and sends TURN_ORDER packet, then calls setInitialTurnOrder
+    // - Responder: waits for TURN_ORDER packet, then calls setInitialTurnOrder
 
-    // Enemy Pokémon sprite
-    const Pokemon* enemyPokemon = enemyPlayer->getActivePokemon();
-    QString enemySpritePath = ":/Battle/assets/pokemon_sprites/006_charizard/front.png";
-    if (enemyPokemon) {
-        enemySpritePath = QString::fromStdString(enemyPokemon->getFrontSpritePath());
-    }
-    QPixmap enemyPx(enemySpritePath);
-    if (enemyPx.isNull()) {
-        if (enemyPokemon) {
-            QString spriteDir = QString::fromStdString(enemyPokemon->getSpriteDir());
-            enemySpritePath = ":/" + spriteDir + "/front.png";
-            enemyPx = QPixmap(enemySpritePath);
+    // Any party member can be switched in; decode their back sprites up front
+    if (gamePlayer) {
+        for (const Pokemon &member : gamePlayer->getTeam()) {
+            SpriteCache::prefetchPokemon(member.getDexNumber(), false);
         }
-        if (enemyPx.isNull()) {
-            enemyPx = QPixmap(":/Battle/assets/pokemon_sprites/006_charizard/front.png");
-        }
-    }
-    if (!enemyPx.isNull()) {
-        float sx = 130.0f / enemyPx.width();
-        float sy = 130.0f / enemyPx.height();
-        float scale = std::min(sx, sy);
-
-        battleEnemyItem = battleScene->addPixmap(enemyPx);
-        battleEnemyItem->setScale(scale);
-
-        qreal w = enemyPx.width() * scale;
-        battleEnemyItem->setPos(280, 5);
-        battleEnemyItem->setZValue(2);
     }
 
-    // Setup UI
-    setupBattleUI();
-
-    // 👉 Override the auto "What will X do?" text from setupBattleUI
-    battleTextTimer.stop();
-    if (battleTextItem) {
-        battleTextItem->setPlainText("");
-    }
-    fullBattleText.clear();
-    battleTextIndex = 0;
+    // The scene is kept between battles; put everything back in place
+    resetBattleScene();
 
     // Switch to battle scene
     view->setScene(battleScene);
@@ -204,7 +142,7 @@ void BattleSequence::startBattle(Player* player, Player* enemy, BattleSystem* bs
     battleSystem->startBattle();
 
     // Update UI with initial state
-    updateBattleUI();
+    updateBattleUI(false);
 
     // =====================================================
     // INTRO SEQUENCE:
@@ -220,7 +158,7 @@ void BattleSequence::startBattle(Player* player, Player* enemy, BattleSystem* bs
     animations.animateBattleEntrances(this);
 
     // 2. After entrances are basically done
-    QTimer::singleShot(1700, [=]() {
+    timeline.after(1700, [=]() {
         if (!battleSystem) return;
 
         QString enemyName = battleSystem->getEnemyPokemonName();
@@ -230,7 +168,7 @@ void BattleSequence::startBattle(Player* player, Player* enemy, BattleSystem* bs
         startTextAnimation();
 
         // 3. After text finishes revealing, play trainer throw
-        QTimer::singleShot(1600, [=]() {
+        timeline.after(1600, [=]() {
 
             animations.animateTrainerThrow(this, [=]() {
 
@@ -239,40 +177,17 @@ void BattleSequence::startBattle(Player* player, Player* enemy, BattleSystem* bs
                     battlePlayerPokemonItem->setVisible(true);
 
                     // FLASH BURST
-                    QGraphicsEllipseItem *flash = new QGraphicsEllipseItem();
-                    flash->setRect(
-                        battlePlayerPokemonItem->x() - 40,
-                        battlePlayerPokemonItem->y() - 40,
-                        80, 80
-                        );
-                    flash->setBrush(Qt::white);
-                    flash->setPen(Qt::NoPen);
-                    flash->setOpacity(0.0);
-                    flash->setZValue(999);
-                    battleScene->addItem(flash);
-
-                    auto *burst = new QVariantAnimation(this);
-                    burst->setDuration(260);
-                    burst->setStartValue(0.0);
-                    burst->setKeyValueAt(0.3, 1.0);
-                    burst->setEndValue(0.0);
-
-                    QObject::connect(burst, &QVariantAnimation::valueChanged,
-                                     [=](const QVariant &v) {
-                                         flash->setOpacity(v.toReal());
-                                     });
-
-                    QObject::connect(burst, &QVariantAnimation::finished,
-                                     [=]() {
-                                         battleScene->removeItem(flash);
-                                         delete flash;
-                                     });
-
-                    burst->start(QAbstractAnimation::DeleteWhenStopped);
+                    EffectSpec flash;
+                    flash.center = battlePlayerPokemonItem->pos();
+                    flash.startSize = 80;
+                    flash.endSize = 80;
+                    flash.durationMs = timeline.scaled(260);
+                    flash.peakAt = 0.3;
+                    effects.spawn(flash);
 
                     // SHAKE
                     auto *shake = new QVariantAnimation(this);
-                    shake->setDuration(350);
+                    shake->setDuration(timeline.scaled(350));
                     shake->setStartValue(0);
                     shake->setKeyValueAt(0.25, -6);
                     shake->setKeyValueAt(0.50,  6);
@@ -293,7 +208,7 @@ void BattleSequence::startBattle(Player* player, Player* enemy, BattleSystem* bs
                 startTextAnimation();
 
                 // 6. After brief delay, enable menu and slide it in
-                QTimer::singleShot(1200, [=]() {
+                timeline.after(1200, [=]() {
                     // NOW enable menu interaction
                     inBattleMenu = true;
 
@@ -326,38 +241,137 @@ void BattleSequence::closeBattle()
     inBattleMenu = false;
     inBagMenu = false;
     inPokemonMenu = false;
+    resyncWatchdog.stop();
+    textStartMs = -1;
+    timeline.clear();
 
-    destroyMoveMenu();
-    destroyBagMenu();
-    destroyPokemonMenu();
-
-    // Clean up battle scene to prevent memory leaks and crashes
-    if (battleScene) {
-        battleScene->clear();  // Remove all items
-        delete battleScene;
-        battleScene = nullptr;
-    }
-
-    // Reset all sprite pointers
-    battleTrainerItem = nullptr;
-    battlePlayerPokemonItem = nullptr;
-    battleEnemyItem = nullptr;
-    dialogueBoxSprite = nullptr;
-    commandBoxSprite = nullptr;
-    battleCursorSprite = nullptr;
-    battleTextItem = nullptr;
-    enemyPokemonNameText = nullptr;
-    playerPokemonNameText = nullptr;
-    enemyHpBackSprite = nullptr;
-    playerHpBackSprite = nullptr;
-    enemyHpMask = nullptr;
-    playerHpMask = nullptr;
-    enemyHpFill = nullptr;
-    playerHpFill = nullptr;
+    // The scene and its items stay alive for the next battle; just put the menus away
+    hideMoveMenu();
+    hideBagMenu();
+    hidePokemonMenu();
+
+    // The window deletes both once it has handled battleEnded
+    battleSystem = nullptr;
+    enemyPlayer = nullptr;
 
     emit battleEnded();
 }
 
+void BattleSequence::buildBattleScene()
+{
+    battleScene = new QGraphicsScene(0, 0, 480, 272, this);
+    battleScene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    // Background
+    QPixmap battleBg = SpriteCache::pixmap(":/assets/battle/battle_bg.png");
+    if (battleBg.isNull()) {
+        battleBg = QPixmap(480, 272);
+        battleBg.fill(Qt::black);
+        QGraphicsPixmapItem* bgItem = battleScene->addPixmap(battleBg);
+        bgItem->setZValue(0);
+    } else {
+        QGraphicsPixmapItem* bgItem = battleScene->addPixmap(battleBg);
+        qreal scaleX = 480.0 / battleBg.width();
+        qreal scaleY = 200.0 / battleBg.height();
+        qreal scale = std::max(scaleX, scaleY);
+        bgItem->setScale(scale);
+
+        qreal scaledHeight = battleBg.height() * scale;
+        qreal yOffset = 200 - scaledHeight;
+        bgItem->setPos(0, yOffset);
+        bgItem->setZValue(0);
+    }
+
+    QGraphicsRectItem* bottomBg = new QGraphicsRectItem(0, 200, 480, 72);
+    bottomBg->setBrush(Qt::black);
+    bottomBg->setPen(Qt::NoPen);
+    bottomBg->setZValue(1);
+    battleScene->addItem(bottomBg);
+
+    // Player trainer sprite
+    QPixmap trainerPx = SpriteCache::pixmap(":/assets/battle/trainer.png");
+    if (!trainerPx.isNull()) {
+        float sx = 130.0f / trainerPx.width();
+        float sy = 130.0f / trainerPx.height();
+        float scale = std::min(sx, sy);
+
+        battleTrainerItem = battleScene->addPixmap(trainerPx);
+        battleTrainerItem->setScale(scale);
+        battleTrainerItem->setZValue(0);
+    }
+
+    // Pokemon sprites; resetBattleScene() sets the pixmaps for each battle
+    battlePlayerPokemonItem = battleScene->addPixmap(QPixmap());
+    battlePlayerPokemonItem->setZValue(2);
+    battlePlayerPokemonItem->setVisible(false);
+
+    battleEnemyItem = battleScene->addPixmap(QPixmap());
+    battleEnemyItem->setZValue(2);
+
+    // Flashes, rings and particles borrow from here
+    effects.attach(battleScene);
+
+    setupBattleUI();
+
+    // Move, bag and Pokemon menus: filled in and shown on demand
+    buildMenuPanel(movePanel, 80, 35, 4);
+    buildMenuPanel(bagPanel, 120, 20, 6);
+    buildMenuPanel(pokemonPanel, 140, 25, 6);
+}
+
+void BattleSequence::resetBattleScene()
+{
+    timeline.clear();
+    effects.clear();
+    hideMoveMenu();
+    hideBagMenu();
+    hidePokemonMenu();
+
+    // The entrance slide and the throw move and hide the trainer
+    if (battleTrainerItem) {
+        qreal h = battleTrainerItem->pixmap().height() * battleTrainerItem->scale();
+        battleTrainerItem->setPos(20, 272 - h - 70);
+        battleTrainerItem->setVisible(true);
+    }
+
+    // Player's Pokemon sprite, hidden until the throw animation finishes
+    QPixmap playerPx = SpriteCache::pokemon(gamePlayer ? gamePlayer->getActivePokemon() : nullptr, false);
+    if (!playerPx.isNull()) {
+        float scale = std::min(140.0f / playerPx.width(), 140.0f / playerPx.height());
+        battlePlayerPokemonItem->setPixmap(playerPx);
+        battlePlayerPokemonItem->setScale(scale);
+        battlePlayerPokemonItem->setPos(60, 272 - playerPx.height() * scale - 50);
+    }
+    battlePlayerPokemonItem->setVisible(false);
+
+    // Enemy Pokémon sprite
+    QPixmap enemyPx = SpriteCache::pokemon(enemyPlayer ? enemyPlayer->getActivePokemon() : nullptr, true);
+    if (!enemyPx.isNull()) {
+        float scale = std::min(130.0f / enemyPx.width(), 130.0f / enemyPx.height());
+        battleEnemyItem->setPixmap(enemyPx);
+        battleEnemyItem->setScale(scale);
+    }
+    battleEnemyItem->setPos(280, 5);
+    battleEnemyItem->setVisible(true);
+
+    // Command menu, possibly left mid-slide by the last battle
+    commandBoxSprite->setPos(480 - 160 - 50, 272 - 64 - 17);
+    int px[4] = {25, 100, 25, 100};
+    int py[4] = {18, 18, 42, 42};
+    for (int i = 0; i < battleMenuOptions.size(); ++i) {
+        battleMenuOptions[i]->setPos(commandBoxSprite->pos().x() + px[i] * commandBoxSprite->scale(),
+                                     commandBoxSprite->pos().y() + py[i] * commandBoxSprite->scale());
+        battleMenuOptions[i]->setVisible(false);
+    }
+    commandBoxSprite->setVisible(false);
+    battleCursorSprite->setVisible(false);
+    battleMenuIndex = 0;
+
+    textStartMs = -1;
+    setBattleText("");
+
+    updateBattleCursor();
+}
 
 void BattleSequence::setupBattleUI()
 {
@@ -409,12 +423,7 @@ void BattleSequence::setupBattleUI()
     enemyHpMask->setZValue(3);
     battleScene->addItem(enemyHpMask);
 
-    enemyHpFill = new QGraphicsRectItem(0, 0, 96, 6);
-    enemyHpFill->setBrush(QColor("#7BD77B"));
-    enemyHpFill->setPen(Qt::NoPen);
-    enemyHpFill->setPos(enemyBoxX + 13, enemyBoxY + 25);
-    enemyHpFill->setZValue(4);
-    battleScene->addItem(enemyHpFill);
+    enemyHpBar.attach(battleScene, QPointF(enemyBoxX + 13, enemyBoxY + 25), 96, 6, 4);
 
     qreal playerBoxX = 270;
     qreal playerBoxY = 145;
@@ -454,12 +463,7 @@ void BattleSequence::setupBattleUI()
     playerHpMask->setZValue(3);
     battleScene->addItem(playerHpMask);
 
-    playerHpFill = new QGraphicsRectItem(0, 0, 103, 6);
-    playerHpFill->setBrush(QColor("#7BD77B"));
-    playerHpFill->setPen(Qt::NoPen);
-    playerHpFill->setPos(playerBoxX + 13, playerBoxY + 29);
-    playerHpFill->setZValue(4);
-    battleScene->addItem(playerHpFill);
+    playerHpBar.attach(battleScene, QPointF(playerBoxX + 13, playerBoxY + 29), 103, 6, 4);
 
     enemyPokemonNameText = new QGraphicsTextItem();
     enemyPokemonNameText->setDefaultTextColor(Qt::black);
@@ -475,7 +479,7 @@ void BattleSequence::setupBattleUI()
     playerPokemonNameText->setZValue(5);
     battleScene->addItem(playerPokemonNameText);
 
-    QPixmap dialogPx(":/assets/battle/ui/dialogue_box.png");
+    QPixmap dialogPx = SpriteCache::pixmap(":/assets/battle/ui/dialogue_box.png");
     dialogueBoxSprite = battleScene->addPixmap(dialogPx);
     {
         double sx = 480.0 / dialogPx.width();
@@ -492,30 +496,14 @@ void BattleSequence::setupBattleUI()
     QFont textFont("Pokemon Fire Red", 11, QFont::Bold);
     textFont.setStyleStrategy(QFont::NoAntialias);
 
-    battleTextItem = new QGraphicsTextItem();
-    battleTextItem->setDefaultTextColor(Qt::white);
-    battleTextItem->setFont(textFont);
-    battleTextItem->setPos(dialogueBoxSprite->pos().x() + 18,
-                           dialogueBoxSprite->pos().y() + 14);
+    // +4 keeps the text where QGraphicsTextItem's document margin put it
+    battleTextItem = new GlyphTextItem(textFont, Qt::white);
+    battleTextItem->setPos(dialogueBoxSprite->pos().x() + 18 + 4,
+                           dialogueBoxSprite->pos().y() + 14 + 4);
     battleTextItem->setZValue(3);
     battleScene->addItem(battleTextItem);
 
-    // Set initial battle text based on turn order for PvP
-    if (battleSystem && battleSystem->getPvpMode()) {
-        if (isMyTurn) {
-            fullBattleText = "What will " + battleSystem->getPlayerPokemonName() + " do?";
-        } else {
-            fullBattleText = "Waiting for opponent's turn...";
-            inBattleMenu = false; // Disable menu if not our turn
-        }
-    } else {
-        fullBattleText = "What will " + (battleSystem ? battleSystem->getPlayerPokemonName() : "BULBASAUR") + " do?";
-    }
-    battleTextIndex = 0;
-    battleTextItem->setPlainText("");
-    battleTextTimer.start(30);
-
-    QPixmap cmdBox(":/assets/battle/ui/command_box.png");
+    QPixmap cmdBox = SpriteCache::pixmap(":/assets/battle/ui/command_box.png");
     commandBoxSprite = battleScene->addPixmap(cmdBox);
     commandBoxSprite->setPos(480 - 160 - 50, 272 - 64 - 17);
     commandBoxSprite->setScale(1.3);
@@ -536,7 +524,7 @@ void BattleSequence::setupBattleUI()
         battleMenuOptions.push_back(t);
     }
 
-    QPixmap arrow(":/assets/battle/ui/arrow_cursor.png");
+    QPixmap arrow = SpriteCache::pixmap(":/assets/battle/ui/arrow_cursor.png");
     battleCursorSprite = battleScene->addPixmap(arrow);
     battleCursorSprite->setScale(2.0);
     battleCursorSprite->setZValue(5);
@@ -552,8 +540,9 @@ void BattleSequence::setupBattleUI()
     updateBattleUI();
 }
 
-void BattleSequence::updateBattleUI()
+void BattleSequence::updateBattleUI(bool animateHp)
 {
+    PROFILE_ZONE("battle.updateUI");
     if (!battleSystem) return;
 
     if (enemyPokemonNameText) {
@@ -581,25 +570,26 @@ void BattleSequence::updateBattleUI()
     int enemyHP = battleSystem->getEnemyHP();
     int enemyMaxHP = battleSystem->getEnemyMaxHP();
 
-    if (playerMaxHP > 0 && playerHpFill) {
-        float playerHpPercent = (float)playerHP / (float)playerMaxHP;
-        playerHpFill->setRect(0, 0, 103 * playerHpPercent, 6);
-        setHpColor(playerHpFill, playerHpPercent);
+    // One bar step per frame at 1x; 0 (instant speed, or a snap) jumps
+    const int stepMs = animateHp ? timeline.scaled(16) : 0;
+
+    if (playerMaxHP > 0) {
+        playerHpBar.animateTo(playerHP, playerMaxHP, stepMs);
     }
 
-    if (enemyMaxHP > 0 && enemyHpFill) {
-        float enemyHpPercent = (float)enemyHP / (float)enemyMaxHP;
-        enemyHpFill->setRect(0, 0, 96 * enemyHpPercent, 6);
-        setHpColor(enemyHpFill, enemyHpPercent);
+    if (enemyMaxHP > 0) {
+        enemyHpBar.animateTo(enemyHP, enemyMaxHP, stepMs);
     }
 }
 
-
-void BattleSequence::setHpColor(QGraphicsRectItem *hpBar, float hpPercent)
+void BattleSequence::afterHpBars(const BattleTimeline_BT::Action &next)
 {
-    if (hpPercent > 0.5f)       hpBar->setBrush(QColor("#3CD75F"));
-    else if (hpPercent > 0.2f)  hpBar->setBrush(QColor("#FFCB43"));
-    else                        hpBar->setBrush(QColor("#FF4949"));
+    timeline.waitFor([this](BattleTimeline_BT::Action done) {
+        playerHpBar.whenStopped([this, done]() {
+            enemyHpBar.whenStopped(done);
+        });
+    });
+    timeline.call(next);
 }
 
 void BattleSequence::setBattleText(const QString &text)
@@ -607,20 +597,53 @@ void BattleSequence::setBattleText(const QString &text)
     fullBattleText = text;
     battleTextIndex = 0;
     if (battleTextItem) {
-        battleTextItem->setPlainText("");
+        // Laid out once here; the reveal only raises the visible count
+        battleTextItem->setText(text);
+        battleTextItem->setVisibleCount(0);
     }
 }
 
 void BattleSequence::startTextAnimation()
 {
-    battleTextTimer.start(22);
+    if (timeline.isInstant()) {
+        finishTextAnimation();
+        return;
+    }
+    textStepMs = qMax(1, timeline.scaled(22));
+    textStartMs = timeline.now();
+    startFrames();
+}
+
+void BattleSequence::finishTextAnimation()
+{
+    textStartMs = -1;
+    battleTextIndex = fullBattleText.size();
+    if (battleTextItem) {
+        battleTextItem->setVisibleCount(battleTextIndex);
+    }
 }
 
 void BattleSequence::handleBattleKey(QKeyEvent *event)
 {
+    PROFILE_ZONE("battle.key");
     if (!inBattle || !battleSystem)
         return;
 
+    // Q/SELECT cycles the battle speed at any point in the battle
+    if (event->key() == Qt::Key_Q || event->key() == Qt::Key_Select) {
+        timeline.cycleSpeed();
+        return;
+    }
+
+    // A/Enter between menus finishes the current message and skips its wait
+    if ((event->key() == Qt::Key_Return || event->key() == Qt::Key_Enter)
+        && !isInMenu() && !battleSystem->isWaitingForPlayerMove()
+        && !timeline.isIdle()) {
+        finishTextAnimation();
+        timeline.skipWait();
+        return;
+    }
+
     // In single-player battles, block input while the enemy turn is executing.
     // In PvP mode, we never use BattleState::EXECUTING_TURN as a lock, so we
     // should NOT block here or the local player can get softlocked.
@@ -721,21 +744,21 @@ void BattleSequence::handleBattleKey(QKeyEvent *event)
     else if (key == Qt::Key_Escape || key == Qt::Key_B) {
         // B button / Escape: Go back to main battle menu
         if (inBagMenu) {
-            destroyBagMenu();
+            hideBagMenu();
             inBagMenu = false;
             inBattleMenu = true;
             battleMenuIndex = 0;
             updateBattleCursor();
             return;
         } else if (inPokemonMenu) {
-            destroyPokemonMenu();
+            hidePokemonMenu();
             inPokemonMenu = false;
             inBattleMenu = true;
             battleMenuIndex = 0;
             updateBattleCursor();
             return;
         } else if (inMoveMenu) {
-            destroyMoveMenu();
+            hideMoveMenu();
             inMoveMenu = false;
             inBattleMenu = true;
             battleMenuIndex = 0;
@@ -796,61 +819,28 @@ void BattleSequence::playerSelectedOption(int index)
     if (index == 0) { // FIGHT
         battleSystem->processAction(BattleAction::FIGHT);
 
-        destroyBagMenu();
-        destroyPokemonMenu();
-        destroyMoveMenu();
+        hideBagMenu();
+        hidePokemonMenu();
+        hideMoveMenu();
 
         std::vector<QString> moves = battleSystem->getPlayerMoves();
         std::vector<int> pp = battleSystem->getPlayerMovePP();
         std::vector<int> maxPP = battleSystem->getPlayerMoveMaxPP();
 
-        QFont f("Pokemon Fire Red", 9, QFont::Bold);
-        f.setStyleStrategy(QFont::NoAntialias);  // Smoother text
-
-        const qreal boxW = 240, boxH = 80;
-        qreal boxX = dialogueBoxSprite->pos().x() + 10;
-        qreal boxY = dialogueBoxSprite->pos().y() - boxH - 4;
-
-        // Shadow for depth
-        QGraphicsRectItem *shadow = new QGraphicsRectItem(boxX + 3, boxY + 3, boxW, boxH);
-        shadow->setBrush(QColor(0, 0, 0, 100));
-        shadow->setPen(Qt::NoPen);
-        shadow->setZValue(2);
-        battleScene->addItem(shadow);
-
-        moveMenuRect = new QGraphicsRectItem(boxX, boxY, boxW, boxH);
-        moveMenuRect->setBrush(QColor(245, 245, 220));  // Beige background
-        moveMenuRect->setPen(QPen(QColor(70, 130, 180), 3));  // Blue border
-        moveMenuRect->setZValue(3);
-        battleScene->addItem(moveMenuRect);
-
-        moveMenuOptions.clear();
+        QStringList labels;
         int numMoves = std::min(4, (int)moves.size() + 1);
         for (int i = 0; i < numMoves; ++i) {
-            QString label;
             if (i < (int)moves.size()) {
                 QString moveName = moves[i];
                 if (moveName.length() > 12) {
                     moveName = moveName.left(10) + "...";
                 }
-                label = moveName + "\nPP " + QString::number(pp[i]) + "/" + QString::number(maxPP[i]);
+                labels << moveName + "\nPP " + QString::number(pp[i]) + "/" + QString::number(maxPP[i]);
             } else {
-                label = "BACK";
+                labels << "BACK";
             }
-
-            QGraphicsTextItem *t = new QGraphicsTextItem(label);
-            t->setFont(f);
-            t->setDefaultTextColor(QColor(44, 62, 80));  // Dark blue-gray text
-
-            int row = i / 2;
-            int col = i % 2;
-            t->setPos(boxX + 12 + col * 115,
-                      boxY + 10 + row * 35);
-            t->setZValue(4);
-
-            battleScene->addItem(t);
-            moveMenuOptions.push_back(t);
         }
+        showMenuPanel(movePanel, moveMenuOptions, labels);
 
         inBattleMenu = false;
         battleMenuIndex = 0;
@@ -883,7 +873,7 @@ void BattleSequence::playerSelectedOption(int index)
             // Stay in the main battle menu so the player can choose another action
             inBattleMenu = true;
             battleMenuIndex = 0;
-            QTimer::singleShot(1000, [=]() {
+            timeline.after(1000, [=]() {
                 setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
                 startTextAnimation();
                 updateBattleCursor();
@@ -902,13 +892,13 @@ void BattleSequence::playerSelectedOption(int index)
         inBattleMenu = false;
 
         if (runSuccessful) {
-            QTimer::singleShot(1000, [=]() {
+            timeline.after(1000, [=]() {
                 fadeOutBattleScreen([=]() {
                     closeBattle();
                 });
             });
         } else {
-            QTimer::singleShot(1000, [=]() {
+            timeline.after(1000, [=]() {
                 enemyTurn();
             });
         }
@@ -918,14 +908,15 @@ void BattleSequence::playerSelectedOption(int index)
 
 void BattleSequence::playerChoseMove(int moveIndex)
 {
+    PROFILE_ZONE("battle.playerMove");
     if (!battleSystem) return;
 
     std::vector<QString> moves = battleSystem->getPlayerMoves();
 
     if (moveIndex >= (int)moves.size()) {
-        destroyMoveMenu();
-        destroyBagMenu();
-        destroyPokemonMenu();
+        hideMoveMenu();
+        hideBagMenu();
+        hidePokemonMenu();
 
         battleSystem->returnToMainMenu();
 
@@ -941,7 +932,7 @@ void BattleSequence::playerChoseMove(int moveIndex)
         return;
     }
 
-    destroyMoveMenu();
+    hideMoveMenu();
     inBattleMenu = false;
 
     // In PvP mode, we need to handle turns differently (alternating turns)
@@ -980,7 +971,7 @@ void BattleSequence::playerChoseMove(int moveIndex)
         if (uartComm) {
             QString dataStr = QString::number(moveIndex) + "," + QString::number(precalculatedDamage);
             BattlePacket turnPacket(PacketType::TURN, dataStr);
-            uartComm->sendPacket(turnPacket);
+            sendTurnPacket(turnPacket);
         }
 
         // Execute the player's move immediately (it's their turn)
@@ -993,140 +984,147 @@ void BattleSequence::playerChoseMove(int moveIndex)
     setBattleText(battleSystem->getPlayerPokemonName() + " used " + moveName + "!");
     startTextAnimation();
 
-    QTimer::singleShot(500, [=]() {
+    timeline.after(500, [=]() {
         animations.animateAttackImpact(this, true);
     });
 
-    QTimer::singleShot(1000, [=]() {
+    timeline.after(500, [=]() {
         // Normal battle flow (non-PvP)
         battleSystem->processFightAction(moveIndex);
 
         updateBattleUI();
 
-        if (battleSystem->isBattleOver()) {
-            Player* winner = battleSystem->getWinner();
-            if (winner == gamePlayer) {
-                // Player won - remove fainted Pokemon from team
-                if (gamePlayer) {
-                    auto& team = gamePlayer->getTeam();
-                    // Remove fainted Pokemon (iterate backwards to avoid index issues)
-                    for (int i = static_cast<int>(team.size()) - 1; i >= 0; --i) {
-                        if (team[i].isFainted()) {
-                            gamePlayer->removePokemon(i);
+        // The rest waits until the HP bars have drained
+        afterHpBars([=]() {
+            if (battleSystem->isBattleOver()) {
+                Player* winner = battleSystem->getWinner();
+                if (winner == gamePlayer) {
+                    // Player won - remove fainted Pokemon from team
+                    if (gamePlayer) {
+                        auto& team = gamePlayer->getTeam();
+                        // Remove fainted Pokemon (iterate backwards to avoid index issues)
+                        for (int i = static_cast<int>(team.size()) - 1; i >= 0; --i) {
+                            if (team[i].isFainted()) {
+                                gamePlayer->removePokemon(i);
+                            }
                         }
                     }
-                }
-                setBattleText("The foe fainted!");
-            } else {
-                // Player lost - check if all Pokemon are fainted
-                if (gamePlayer && gamePlayer->isDefeated()) {
-                    setBattleText("You have no Pokemon left!\nYou failed the game!");
-                    startTextAnimation();
+                    setBattleText("The foe fainted!");
+                } else {
+                    // Player lost - check if all Pokemon are fainted
+                    if (gamePlayer && gamePlayer->isDefeated()) {
+                        setBattleText("You have no Pokemon left!\nYou failed the game!");
+                        startTextAnimation();
 
-                    QTimer::singleShot(2000, [=]() {
-                        fadeOutBattleScreen([=]() {
-                            closeBattle();
-                            QApplication::exit(0);
+                        timeline.after(2000, [=]() {
+                            fadeOutBattleScreen([=]() {
+                                closeBattle();
+                                QApplication::exit(0);
+                            });
                         });
-                    });
-                    return;
-                } else {
-                    setBattleText(battleSystem->getPlayerPokemonName() + " fainted...");
+                        return;
+                    } else {
+                        setBattleText(battleSystem->getPlayerPokemonName() + " fainted...");
+                    }
                 }
+                startTextAnimation();
+
+                timeline.after(1200, [=]() {
+                    fadeOutBattleScreen([=]() {
+                        closeBattle();
+                    });
+                });
+                return;
+            }
+
+            // Show enemy's move message first (enemy already moved during processFightAction)
+            // Then check if player's Pokemon fainted and auto-switch
+            QString enemyName = battleSystem->getEnemyPokemonName();
+            if (enemyName.isEmpty()) {
+                enemyName = "The foe";
             }
+
+            QString enemyMoveName = battleSystem->getEnemyLastMoveName();
+            if (enemyMoveName.isEmpty()) {
+                enemyMoveName = "a move";
+            } else {
+                enemyMoveName = capitalizeFirst(enemyMoveName);
+            }
+
+            setBattleText(enemyName + " used " + enemyMoveName + "!");
             startTextAnimation();
 
-            QTimer::singleShot(1200, [=]() {
-                fadeOutBattleScreen([=]() {
-                    closeBattle();
-                });
+            timeline.after(500, [=]() {
+                animations.animateAttackImpact(this, false);
             });
-            return;
-        }
 
-        // Show enemy's move message first (enemy already moved during processFightAction)
-        // Then check if player's Pokemon fainted and auto-switch
-        QString enemyName = battleSystem->getEnemyPokemonName();
-        if (enemyName.isEmpty()) {
-            enemyName = "The foe";
-        }
+            timeline.after(500, [=]() {
+                updateBattleUI();
 
-        QString enemyMoveName = battleSystem->getEnemyLastMoveName();
-        if (enemyMoveName.isEmpty()) {
-            enemyMoveName = "a move";
-        } else {
-            enemyMoveName = capitalizeFirst(enemyMoveName);
-        }
+                // The rest waits until the HP bars have drained
+                afterHpBars([=]() {
+                    // Check if player's Pokemon fainted and auto-switch
+                    if (gamePlayer && gamePlayer->getActivePokemon() && gamePlayer->getActivePokemon()->isFainted()) {
+                        // Show fainted message first
+                        QString faintedName = battleSystem->getPlayerPokemonName();
+                        setBattleText(faintedName + " fainted!");
+                        startTextAnimation();
 
-        setBattleText(enemyName + " used " + enemyMoveName + "!");
-        startTextAnimation();
+                        timeline.after(1000, [=]() {
+                            bool switched = checkAndAutoSwitchPokemon();
+                            if (!switched) {
+                                // No Pokemon available - game over
+                                if (gamePlayer->isDefeated()) {
+                                    setBattleText("You have no Pokemon left!\nYou failed the game!");
+                                    startTextAnimation();
+
+                                    timeline.after(2000, [=]() {
+                                        fadeOutBattleScreen([=]() {
+                                            closeBattle();
+                                            QApplication::exit(0);
+                                        });
+                                    });
+                                    return;
+                                }
+                            } else {
+                                // Successfully switched - show message and return to menu
+                                setBattleText("Go! " + battleSystem->getPlayerPokemonName() + "!");
+                                startTextAnimation();
+
+                                timeline.after(1000, [=]() {
+                                    setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+                                    startTextAnimation();
+
+                                    inBattleMenu = true;
+                                    battleMenuIndex = 0;
+
+                                    hideMoveMenu();
+                                    updateBattleCursor();
+                                });
+                                return;
+                            }
+                        });
+                        return;
+                    }
 
-        QTimer::singleShot(500, [=]() {
-            animations.animateAttackImpact(this, false);
-        });
+                    // Player's Pokemon is still alive, return to menu
+                    setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+                    startTextAnimation();
 
-        QTimer::singleShot(1000, [=]() {
-            updateBattleUI();
+                    inBattleMenu = true;
+                    battleMenuIndex = 0;
 
-            // Check if player's Pokemon fainted and auto-switch
-            if (gamePlayer && gamePlayer->getActivePokemon() && gamePlayer->getActivePokemon()->isFainted()) {
-                // Show fainted message first
-                QString faintedName = battleSystem->getPlayerPokemonName();
-                setBattleText(faintedName + " fainted!");
-                startTextAnimation();
-
-                QTimer::singleShot(1000, [=]() {
-                    bool switched = checkAndAutoSwitchPokemon();
-                    if (!switched) {
-                        // No Pokemon available - game over
-                        if (gamePlayer->isDefeated()) {
-                            setBattleText("You have no Pokemon left!\nYou failed the game!");
-                            startTextAnimation();
-
-                            QTimer::singleShot(2000, [=]() {
-                                fadeOutBattleScreen([=]() {
-                                    closeBattle();
-                                    QApplication::exit(0);
-                                });
-                            });
-                            return;
-                        }
-                    } else {
-                        // Successfully switched - show message and return to menu
-                        setBattleText("Go! " + battleSystem->getPlayerPokemonName() + "!");
-                        startTextAnimation();
-
-                        QTimer::singleShot(1000, [=]() {
-                            setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
-                            startTextAnimation();
-
-                            inBattleMenu = true;
-                            battleMenuIndex = 0;
-
-                            destroyMoveMenu();
-                            updateBattleCursor();
-                        });
-                        return;
-                    }
+                    hideMoveMenu();
+                    updateBattleCursor();
                 });
-                return;
-            }
-
-            // Player's Pokemon is still alive, return to menu
-            setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
-            startTextAnimation();
-
-            inBattleMenu = true;
-            battleMenuIndex = 0;
-
-            destroyMoveMenu();
-            updateBattleCursor();
+            });
         });
     });
 }
 
 void BattleSequence::enemyTurn()
 {
+    PROFILE_ZONE("battle.enemyTurn");
     if (!battleSystem) return;
 
     QString enemyName = battleSystem->getEnemyPokemonName();
@@ -1145,113 +1143,116 @@ void BattleSequence::enemyTurn()
     setBattleText(enemyName + " used " + moveName + "!");
     startTextAnimation();
 
-    QTimer::singleShot(500, [=]() {
+    timeline.after(500, [=]() {
         animations.animateAttackImpact(this, false);
     });
 
-    QTimer::singleShot(1000, [=]() {
+    timeline.after(500, [=]() {
         updateBattleUI();
 
-        if (battleSystem->isBattleOver()) {
-            Player* winner = battleSystem->getWinner();
-            if (winner == gamePlayer) {
-                // Player won - remove fainted Pokemon from team
-                if (gamePlayer) {
-                    auto& team = gamePlayer->getTeam();
-                    // Remove fainted Pokemon (iterate backwards to avoid index issues)
-                    for (int i = static_cast<int>(team.size()) - 1; i >= 0; --i) {
-                        if (team[i].isFainted()) {
-                            gamePlayer->removePokemon(i);
+        // The rest waits until the HP bars have drained
+        afterHpBars([=]() {
+            if (battleSystem->isBattleOver()) {
+                Player* winner = battleSystem->getWinner();
+                if (winner == gamePlayer) {
+                    // Player won - remove fainted Pokemon from team
+                    if (gamePlayer) {
+                        auto& team = gamePlayer->getTeam();
+                        // Remove fainted Pokemon (iterate backwards to avoid index issues)
+                        for (int i = static_cast<int>(team.size()) - 1; i >= 0; --i) {
+                            if (team[i].isFainted()) {
+                                gamePlayer->removePokemon(i);
+                            }
                         }
                     }
-                }
-                setBattleText("The foe fainted!");
-            } else {
-                // Player lost - check if all Pokemon are fainted
-                if (gamePlayer && gamePlayer->isDefeated()) {
-                    setBattleText("You have no Pokemon left!\nYou failed the game!");
-                    startTextAnimation();
-
-                    inBattleMenu = false;
-
-                    QTimer::singleShot(2000, [=]() {
-                        fadeOutBattleScreen([=]() {
-                            closeBattle();
-                            QApplication::exit(0);
-                        });
-                    });
-                    return;
+                    setBattleText("The foe fainted!");
                 } else {
-                    setBattleText(battleSystem->getPlayerPokemonName() + " fainted...");
-                }
-            }
-            startTextAnimation();
-
-            inBattleMenu = false;
-
-            QTimer::singleShot(1400, [=]() {
-                fadeOutBattleScreen([=]() {
-                    closeBattle();
-                });
-            });
-            return;
-        }
-
-        // Check if player's Pokemon fainted and auto-switch
-        if (gamePlayer && gamePlayer->getActivePokemon() && gamePlayer->getActivePokemon()->isFainted()) {
-            // Show fainted message first
-            QString faintedName = battleSystem->getPlayerPokemonName();
-            setBattleText(faintedName + " fainted!");
-            startTextAnimation();
-
-            QTimer::singleShot(1000, [=]() {
-                bool switched = checkAndAutoSwitchPokemon();
-                if (!switched) {
-                    // No Pokemon available - game over
-                    if (gamePlayer->isDefeated()) {
+                    // Player lost - check if all Pokemon are fainted
+                    if (gamePlayer && gamePlayer->isDefeated()) {
                         setBattleText("You have no Pokemon left!\nYou failed the game!");
                         startTextAnimation();
 
                         inBattleMenu = false;
 
-                        QTimer::singleShot(2000, [=]() {
+                        timeline.after(2000, [=]() {
                             fadeOutBattleScreen([=]() {
                                 closeBattle();
                                 QApplication::exit(0);
                             });
                         });
                         return;
+                    } else {
+                        setBattleText(battleSystem->getPlayerPokemonName() + " fainted...");
                     }
-                } else {
-                    // Successfully switched - show message
-                    setBattleText("Go! " + battleSystem->getPlayerPokemonName() + "!");
-                    startTextAnimation();
+                }
+                startTextAnimation();
+
+                inBattleMenu = false;
+
+                timeline.after(1400, [=]() {
+                    fadeOutBattleScreen([=]() {
+                        closeBattle();
+                    });
+                });
+                return;
+            }
+
+            // Check if player's Pokemon fainted and auto-switch
+            if (gamePlayer && gamePlayer->getActivePokemon() && gamePlayer->getActivePokemon()->isFainted()) {
+                // Show fainted message first
+                QString faintedName = battleSystem->getPlayerPokemonName();
+                setBattleText(faintedName + " fainted!");
+                startTextAnimation();
 
-                    QTimer::singleShot(1000, [=]() {
-                        setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+                timeline.after(1000, [=]() {
+                    bool switched = checkAndAutoSwitchPokemon();
+                    if (!switched) {
+                        // No Pokemon available - game over
+                        if (gamePlayer->isDefeated()) {
+                            setBattleText("You have no Pokemon left!\nYou failed the game!");
+                            startTextAnimation();
+
+                            inBattleMenu = false;
+
+                            timeline.after(2000, [=]() {
+                                fadeOutBattleScreen([=]() {
+                                    closeBattle();
+                                    QApplication::exit(0);
+                                });
+                            });
+                            return;
+                        }
+                    } else {
+                        // Successfully switched - show message
+                        setBattleText("Go! " + battleSystem->getPlayerPokemonName() + "!");
                         startTextAnimation();
 
-                        inBattleMenu = true;
-                        battleMenuIndex = 0;
+                        timeline.after(1000, [=]() {
+                            setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+                            startTextAnimation();
 
-                        destroyMoveMenu();
-                        updateBattleCursor();
-                    });
-                    return;
-                }
-            });
-            return;
-        }
+                            inBattleMenu = true;
+                            battleMenuIndex = 0;
 
-        QTimer::singleShot(900, [=]() {
-            setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
-            startTextAnimation();
+                            hideMoveMenu();
+                            updateBattleCursor();
+                        });
+                        return;
+                    }
+                });
+                return;
+            }
 
-            inBattleMenu = true;
-            battleMenuIndex = 0;
+            timeline.after(900, [=]() {
+                setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+                startTextAnimation();
 
-            destroyMoveMenu();
-            updateBattleCursor();
+                inBattleMenu = true;
+                battleMenuIndex = 0;
+
+                hideMoveMenu();
+                updateBattleCursor();
+            });
         });
     });
 }
@@ -1260,79 +1261,33 @@ void BattleSequence::showBagMenu()
 {
     if (!battleSystem || !battleScene) return;
 
-    destroyMoveMenu();
-    destroyPokemonMenu();
-
-    std::vector<QString> items = battleSystem->getBagItems();
-    std::vector<int> quantities = battleSystem->getBagItemQuantities();
-
-    QFont f("Pokemon Fire Red", 9, QFont::Bold);
-    f.setStyleStrategy(QFont::NoAntialias);
+    hideMoveMenu();
+    hidePokemonMenu();
 
-    const qreal boxW = 240, boxH = 120;
-    qreal boxX = dialogueBoxSprite->pos().x() + 10;
-    qreal boxY = dialogueBoxSprite->pos().y() - boxH - 4;
-
-    // Shadow for depth
-    QGraphicsRectItem *shadow = new QGraphicsRectItem(boxX + 3, boxY + 3, boxW, boxH);
-    shadow->setBrush(QColor(0, 0, 0, 100));
-    shadow->setPen(Qt::NoPen);
-    shadow->setZValue(2);
-    battleScene->addItem(shadow);
-
-    bagMenuRect = new QGraphicsRectItem(boxX, boxY, boxW, boxH);
-    bagMenuRect->setBrush(QColor(245, 245, 220));
-    bagMenuRect->setPen(QPen(QColor(70, 130, 180), 3));
-    bagMenuRect->setZValue(3);
-    battleScene->addItem(bagMenuRect);
-
-    bagMenuOptions.clear();
+    QStringList labels;
     bagMenuItemIndices.clear();
 
     // Get actual bag items to map indices correctly
     if (battleSystem && battleSystem->getBattle() && battleSystem->getBattle()->getPlayer1()) {
         const auto& allItems = battleSystem->getBattle()->getPlayer1()->getBag().getItems();
-        int menuIndex = 0;
-        for (size_t i = 0; i < allItems.size() && menuIndex < 6; ++i) {
+        for (size_t i = 0; i < allItems.size() && labels.size() < 6; ++i) {
             if (allItems[i].getQuantity() > 0) {
                 QString itemName = QString::fromStdString(allItems[i].getName());
                 if (itemName.length() > 15) {
                     itemName = itemName.left(13) + "...";
                 }
-                QString label = itemName + " x" + QString::number(allItems[i].getQuantity());
-
-                QGraphicsTextItem *t = new QGraphicsTextItem(label);
-                t->setFont(f);
-                t->setDefaultTextColor(QColor(44, 62, 80));
-
-                int row = menuIndex / 2;
-                int col = menuIndex % 2;
-                t->setPos(boxX + 12 + col * 115,
-                          boxY + 10 + row * 20);
-                t->setZValue(4);
-
-                battleScene->addItem(t);
-                bagMenuOptions.push_back(t);
+                labels << itemName + " x" + QString::number(allItems[i].getQuantity());
                 bagMenuItemIndices.push_back(static_cast<int>(i));
-                menuIndex++;
             }
         }
 
         // Add BACK option
-        if (menuIndex < 6) {
-            QGraphicsTextItem *t = new QGraphicsTextItem("BACK");
-            t->setFont(f);
-            t->setDefaultTextColor(QColor(44, 62, 80));
-            int row = menuIndex / 2;
-            int col = menuIndex % 2;
-            t->setPos(boxX + 12 + col * 115,
-                      boxY + 10 + row * 20);
-            t->setZValue(4);
-            battleScene->addItem(t);
-            bagMenuOptions.push_back(t);
+        if (labels.size() < 6) {
+            labels << "BACK";
             bagMenuItemIndices.push_back(-1);
         }
     }
+    showMenuPanel(bagPanel, bagMenuOptions, labels);
 
     inBagMenu = true;
     inBattleMenu = false;
@@ -1349,8 +1304,8 @@ void BattleSequence::showPokemonMenu()
 {
     if (!battleSystem || !battleScene) return;
 
-    destroyMoveMenu();
-    destroyBagMenu();
+    hideMoveMenu();
+    hideBagMenu();
 
     std::vector<QString> names = battleSystem->getTeamNames();
     std::vector<int> hp = battleSystem->getTeamHP();
@@ -1359,60 +1314,30 @@ void BattleSequence::showPokemonMenu()
     std::vector<bool> fainted = battleSystem->getTeamFainted();
     int activeIndex = battleSystem->getActivePokemonIndex();
 
-    QFont f("Pokemon Fire Red", 9, QFont::Bold);
-    f.setStyleStrategy(QFont::NoAntialias);
-
-    const qreal boxW = 240, boxH = 140;
-    qreal boxX = dialogueBoxSprite->pos().x() + 10;
-    qreal boxY = dialogueBoxSprite->pos().y() - boxH - 4;
-
-    // Shadow for depth
-    QGraphicsRectItem *shadow = new QGraphicsRectItem(boxX + 3, boxY + 3, boxW, boxH);
-    shadow->setBrush(QColor(0, 0, 0, 100));
-    shadow->setPen(Qt::NoPen);
-    shadow->setZValue(2);
-    battleScene->addItem(shadow);
-
-    pokemonMenuRect = new QGraphicsRectItem(boxX, boxY, boxW, boxH);
-    pokemonMenuRect->setBrush(QColor(245, 245, 220));
-    pokemonMenuRect->setPen(QPen(QColor(70, 130, 180), 3));
-    pokemonMenuRect->setZValue(3);
-    battleScene->addItem(pokemonMenuRect);
-
-    pokemonMenuOptions.clear();
+    QStringList labels;
     int numPokemon = std::min(6, (int)names.size() + 1);
     for (int i = 0; i < numPokemon; ++i) {
-        QString label;
         if (i < (int)names.size()) {
             QString pokemonName = capitalizeFirst(names[i]);
             if (pokemonName.length() > 10) {
                 pokemonName = pokemonName.left(8) + "...";
             }
             QString status = fainted[i] ? "FAINTED" : (i == activeIndex ? "ACTIVE" : "");
-            label = pokemonName + " Lv" + QString::number(levels[i]) + "\nHP " + QString::number(hp[i]) + "/" + QString::number(maxHP[i]);
+            QString label = pokemonName + " Lv" + QString::number(levels[i]) + "\nHP " + QString::number(hp[i]) + "/" + QString::number(maxHP[i]);
             if (!status.isEmpty()) {
                 label += "\n" + status;
             }
+            labels << label;
         } else {
-            label = "BACK";
+            labels << "BACK";
         }
+    }
+    showMenuPanel(pokemonPanel, pokemonMenuOptions, labels);
 
-        QGraphicsTextItem *t = new QGraphicsTextItem(label);
-        t->setFont(f);
-        if (i < (int)names.size() && fainted[i]) {
-            t->setDefaultTextColor(Qt::gray);
-        } else {
-            t->setDefaultTextColor(QColor(44, 62, 80));
+    for (int i = 0; i < (int)names.size() && i < pokemonMenuOptions.size(); ++i) {
+        if (fainted[i]) {
+            pokemonMenuOptions[i]->setDefaultTextColor(Qt::gray);
         }
-
-        int row = i / 2;
-        int col = i % 2;
-        t->setPos(boxX + 12 + col * 115,
-                  boxY + 10 + row * 25);
-        t->setZValue(4);
-
-        battleScene->addItem(t);
-        pokemonMenuOptions.push_back(t);
     }
 
     inPokemonMenu = true;
@@ -1437,7 +1362,7 @@ void BattleSequence::playerSelectedBagItem(int index)
 
     // Check if BACK was selected
     if (index >= bagMenuItemIndices.size() || bagMenuItemIndices[index] == -1) {
-        destroyBagMenu(); // Destroy the bag menu when "BACK" is selected
+        hideBagMenu(); // Hide the bag menu when "BACK" is selected
 
         battleSystem->returnToMainMenu();
 
@@ -1474,12 +1399,12 @@ void BattleSequence::playerSelectedBagItem(int index)
             setBattleText("Can't use " + itemName + " in PvP battle!");
             startTextAnimation();
 
-            destroyBagMenu();
+            hideBagMenu();
             inBagMenu = false;
             inBattleMenu = true;
             battleMenuIndex = 0;
 
-            QTimer::singleShot(1000, [=]() {
+            timeline.after(1000, [=]() {
                 setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
                 startTextAnimation();
                 updateBattleCursor();
@@ -1517,7 +1442,7 @@ void BattleSequence::playerSelectedBagItem(int index)
             }
         }
 
-        destroyBagMenu();
+        hideBagMenu();
         inBagMenu = false;
         inBattleMenu = false;
         battleMenuIndex = 0;
@@ -1535,7 +1460,7 @@ void BattleSequence::playerSelectedBagItem(int index)
         if (uartComm) {
             QString data = QString::number(actualItemIndex) + "," + QString::number(healAmount);
             BattlePacket itemPacket(PacketType::ITEM, data);
-            uartComm->sendPacket(itemPacket);
+            sendTurnPacket(itemPacket);
         }
 
         // In PvP, after using an item, we've completed our turn
@@ -1545,7 +1470,7 @@ void BattleSequence::playerSelectedBagItem(int index)
         battleSystem->setWaitingForOpponentTurn(false);
         inBattleMenu = false; // Disable menu immediately to prevent further input
 
-        QTimer::singleShot(1000, [=]() {
+        timeline.after(1000, [=]() {
             setBattleText("Waiting for opponent's turn...");
             startTextAnimation();
             battleMenuIndex = 0;
@@ -1565,7 +1490,7 @@ void BattleSequence::playerSelectedBagItem(int index)
 
     // Use regular item (potion, etc.)
     battleSystem->processBagAction(actualItemIndex);
-    destroyBagMenu();  // Destroy the bag menu after item selection
+    hideBagMenu();  // Hide the bag menu after item selection
 
     inBagMenu = false;
     inBattleMenu = false;
@@ -1576,7 +1501,7 @@ void BattleSequence::playerSelectedBagItem(int index)
 
     updateBattleUI();
 
-    QTimer::singleShot(1000, [=]() {
+    timeline.after(1000, [=]() {
         enemyTurn();
     });
 }
@@ -1594,7 +1519,7 @@ void BattleSequence::playerSelectedPokemon(int index)
     std::vector<QString> names = battleSystem->getTeamNames();
 
     if (index >= (int)names.size()) {
-        destroyPokemonMenu();
+        hidePokemonMenu();
 
         battleSystem->returnToMainMenu();
 
@@ -1611,7 +1536,7 @@ void BattleSequence::playerSelectedPokemon(int index)
 
     int oldActiveIndex = battleSystem->getActivePokemonIndex();
     battleSystem->processPokemonAction(index);
-    destroyPokemonMenu();
+    hidePokemonMenu();
 
     inPokemonMenu = false;
     battleMenuIndex = 0;
@@ -1619,7 +1544,7 @@ void BattleSequence::playerSelectedPokemon(int index)
     setBattleText(battleSystem->getLastMessage().isEmpty() ? "Go! " + battleSystem->getPlayerPokemonName() + "!" : battleSystem->getLastMessage());
     startTextAnimation();
 
-    updateBattleUI();
+    updateBattleUI(false);
 
     bool switchSuccessful = (battleSystem->getActivePokemonIndex() != oldActiveIndex);
     bool isErrorMessage = (fullBattleText.contains("already using") || fullBattleText.contains("fainted"));
@@ -1629,16 +1554,7 @@ void BattleSequence::playerSelectedPokemon(int index)
         if (gamePlayer && battlePlayerPokemonItem) {
             const Pokemon* newActive = gamePlayer->getActivePokemon();
             if (newActive) {
-                QString playerSpritePath = QString::fromStdString(newActive->getBackSpritePath());
-                QPixmap playerPx(playerSpritePath);
-                if (playerPx.isNull()) {
-                    QString spriteDir = QString::fromStdString(newActive->getSpriteDir());
-                    playerSpritePath = ":/" + spriteDir + "/back.png";
-                    playerPx = QPixmap(playerSpritePath);
-                }
-                if (playerPx.isNull()) {
-                    playerPx = QPixmap(":/Battle/assets/pokemon_sprites/006_charizard/back.png");
-                }
+                QPixmap playerPx = SpriteCache::pokemon(newActive, false);
                 if (!playerPx.isNull()) {
                     float sx = 140.0f / playerPx.width();
                     float sy = 140.0f / playerPx.height();
@@ -1660,14 +1576,14 @@ void BattleSequence::playerSelectedPokemon(int index)
                                   QString::number(newActive->getLevel()) + "," +
                                   QString::number(newActive->getCurrentHP());
                 BattlePacket switchPacket(PacketType::SWITCH, dataStr);
-                uartComm->sendPacket(switchPacket);
+                sendTurnPacket(switchPacket);
             }
 
             // Switching counts as using a turn - switch to opponent's turn
             isMyTurn = false;
             inBattleMenu = false;
 
-            QTimer::singleShot(1000, [=]() {
+            timeline.after(1000, [=]() {
                 setBattleText("Waiting for opponent's turn...");
                 startTextAnimation();
                 battleMenuIndex = 0;
@@ -1676,13 +1592,13 @@ void BattleSequence::playerSelectedPokemon(int index)
         } else {
             // Non-PvP: enemy gets a turn after switch
             inBattleMenu = false;
-            QTimer::singleShot(1000, [=]() {
+            timeline.after(1000, [=]() {
                 enemyTurn();
             });
         }
     } else {
         inBattleMenu = true;
-        QTimer::singleShot(1000, [=]() {
+        timeline.after(1000, [=]() {
             setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
             startTextAnimation();
             updateBattleCursor();
@@ -1690,101 +1606,88 @@ void BattleSequence::playerSelectedPokemon(int index)
     }
 }
 
-void BattleSequence::destroyMoveMenu()
+void BattleSequence::buildMenuPanel(MenuPanel &panel, qreal boxH, qreal rowStep, int count)
 {
-    // Clean up shadows
-    if (battleScene) {
-        QList<QGraphicsItem*> items = battleScene->items();
-        for (QGraphicsItem* item : items) {
-            QGraphicsRectItem* rectItem = dynamic_cast<QGraphicsRectItem*>(item);
-            if (rectItem && rectItem->zValue() == 2) {
-                battleScene->removeItem(rectItem);
-                delete rectItem;
-            }
-        }
-    }
+    QFont f("Pokemon Fire Red", 9, QFont::Bold);
+    f.setStyleStrategy(QFont::NoAntialias);
 
-    if (battleScene) {
-        for (QGraphicsTextItem *t : moveMenuOptions) {
-            if (t) {
-                battleScene->removeItem(t);
-                delete t;
-            }
-        }
-    }
-    moveMenuOptions.clear();
+    const qreal boxW = 240;
+    qreal boxX = dialogueBoxSprite->pos().x() + 10;
+    qreal boxY = dialogueBoxSprite->pos().y() - boxH - 4;
 
-    if (moveMenuRect) {
-        if (battleScene)
-            battleScene->removeItem(moveMenuRect);
-        delete moveMenuRect;
-        moveMenuRect = nullptr;
+    // Shadow for depth
+    panel.shadow = new QGraphicsRectItem(boxX + 3, boxY + 3, boxW, boxH);
+    panel.shadow->setBrush(QColor(0, 0, 0, 100));
+    panel.shadow->setPen(Qt::NoPen);
+    panel.shadow->setZValue(2);
+    panel.shadow->setVisible(false);
+    battleScene->addItem(panel.shadow);
+
+    panel.box = new QGraphicsRectItem(boxX, boxY, boxW, boxH);
+    panel.box->setBrush(QColor(245, 245, 220));  // Beige background
+    panel.box->setPen(QPen(QColor(70, 130, 180), 3));  // Blue border
+    panel.box->setZValue(3);
+    panel.box->setVisible(false);
+    battleScene->addItem(panel.box);
+
+    // Two columns of labels
+    for (int i = 0; i < count; ++i) {
+        QGraphicsTextItem *t = new QGraphicsTextItem();
+        t->setFont(f);
+        int row = i / 2;
+        int col = i % 2;
+        t->setPos(boxX + 12 + col * 115,
+                  boxY + 10 + row * rowStep);
+        t->setZValue(4);
+        t->setVisible(false);
+        battleScene->addItem(t);
+        panel.labels.push_back(t);
     }
 }
 
-void BattleSequence::destroyBagMenu()
+void BattleSequence::showMenuPanel(MenuPanel &panel, QVector<QGraphicsTextItem*> &options, const QStringList &labels)
 {
-    // Clean up shadows
-    if (battleScene) {
-        QList<QGraphicsItem*> items = battleScene->items();
-        for (QGraphicsItem* item : items) {
-            QGraphicsRectItem* rectItem = dynamic_cast<QGraphicsRectItem*>(item);
-            if (rectItem && rectItem->zValue() == 2) {
-                battleScene->removeItem(rectItem);
-                delete rectItem;
-            }
-        }
-    }
-
-    if (battleScene) {
-        for (QGraphicsTextItem *t : bagMenuOptions) {
-            if (t) {
-                battleScene->removeItem(t);
-                delete t;
-            }
+    panel.shadow->setVisible(true);
+    panel.box->setVisible(true);
+
+    options.clear();
+    for (int i = 0; i < panel.labels.size(); ++i) {
+        QGraphicsTextItem *t = panel.labels[i];
+        if (i < labels.size()) {
+            t->setPlainText(labels[i]);
+            t->setDefaultTextColor(QColor(44, 62, 80));  // Dark blue-gray text
+            t->setVisible(true);
+            options.push_back(t);
+        } else {
+            t->setVisible(false);
         }
     }
-    bagMenuOptions.clear();
-    bagMenuItemIndices.clear();
+}
 
-    if (bagMenuRect) {
-        if (battleScene)
-            battleScene->removeItem(bagMenuRect);
-        delete bagMenuRect;
-        bagMenuRect = nullptr;
+void BattleSequence::hideMenuPanel(MenuPanel &panel, QVector<QGraphicsTextItem*> &options)
+{
+    if (panel.shadow) panel.shadow->setVisible(false);
+    if (panel.box) panel.box->setVisible(false);
+    for (QGraphicsTextItem *t : panel.labels) {
+        t->setVisible(false);
     }
+    options.clear();
 }
 
-void BattleSequence::destroyPokemonMenu()
+void BattleSequence::hideMoveMenu()
 {
-    // Clean up shadows
-    if (battleScene) {
-        QList<QGraphicsItem*> items = battleScene->items();
-        for (QGraphicsItem* item : items) {
-            QGraphicsRectItem* rectItem = dynamic_cast<QGraphicsRectItem*>(item);
-            if (rectItem && rectItem->zValue() == 2) {
-                battleScene->removeItem(rectItem);
-                delete rectItem;
-            }
-        }
-    }
+    hideMenuPanel(movePanel, moveMenuOptions);
+}
 
-    if (battleScene) {
-        for (QGraphicsTextItem *t : pokemonMenuOptions) {
-            if (t) {
-                battleScene->removeItem(t);
-                delete t;
-            }
-        }
-    }
-    pokemonMenuOptions.clear();
+void BattleSequence::hideBagMenu()
+{
+    hideMenuPanel(bagPanel, bagMenuOptions);
+    bagMenuItemIndices.clear();
+}
 
-    if (pokemonMenuRect) {
-        if (battleScene)
-            battleScene->removeItem(pokemonMenuRect);
-        delete pokemonMenuRect;
-        pokemonMenuRect = nullptr;
-    }
+void BattleSequence::hidePokemonMenu()
+{
+    hideMenuPanel(pokemonPanel, pokemonMenuOptions);
 }
 
 void BattleSequence::battleZoomReveal()
@@ -1821,7 +1724,7 @@ void BattleSequence::fadeOutBattleScreen(std::function<void()> onFinished)
     }
 
     fadeAnim->stop();
-    fadeAnim->setDuration(350);
+    fadeAnim->setDuration(timeline.scaled(350));
     fadeAnim->setStartValue(1.0);
     fadeAnim->setEndValue(0.0);
 
@@ -1845,11 +1748,11 @@ void BattleSequence::attemptCatchPokemon(int itemIndex)
     if (!battleSystem->getBattle()->getIsWildBattle()) {
         setBattleText("You can't catch another trainer's Pokemon!");
         startTextAnimation();
-        destroyBagMenu();
+        hideBagMenu();
         inBagMenu = false;
         inBattleMenu = true;
         battleMenuIndex = 0;
-        QTimer::singleShot(1500, [=]() {
+        timeline.after(1500, [=]() {
             updateBattleCursor();
         });
         return;
@@ -1867,7 +1770,7 @@ void BattleSequence::attemptCatchPokemon(int itemIndex)
     pokeball.use();
 
     // Hide bag menu during throw animation
-    destroyBagMenu();
+    hideBagMenu();
     inBagMenu = false;
 
     // Hide player Pokemon during catch attempt
@@ -1912,13 +1815,13 @@ void BattleSequence::attemptCatchPokemon(int itemIndex)
             }
 
             startTextAnimation();
-            destroyBagMenu();
+            hideBagMenu();
             inBagMenu = false;
             inBattleMenu = false;
 
             // Player Pokemon stays hidden since battle is ending
             // End battle
-            QTimer::singleShot(2000, [=]() {
+            timeline.after(2000, [=]() {
                 fadeOutBattleScreen([=]() {
                     closeBattle();
                 });
@@ -1927,51 +1830,29 @@ void BattleSequence::attemptCatchPokemon(int itemIndex)
             // Failed to catch
             setBattleText("The wild " + QString::fromStdString(enemyPokemon->getName()) + " broke free!");
             startTextAnimation();
-            destroyBagMenu();
+            hideBagMenu();
             inBagMenu = false;
             inBattleMenu = false;
             battleMenuIndex = 0;
 
             // Wait a moment, then bring player Pokemon back
-            QTimer::singleShot(1200, [=]() {
+            timeline.after(1200, [=]() {
                 if (battlePlayerPokemonItem) {
                     battlePlayerPokemonItem->setVisible(true);
 
                     // Flash effect on return
-                    QGraphicsEllipseItem *flash = new QGraphicsEllipseItem();
-                    flash->setRect(
-                        battlePlayerPokemonItem->x() - 30,
-                        battlePlayerPokemonItem->y() - 30,
-                        60, 60
-                        );
-                    flash->setBrush(Qt::white);
-                    flash->setPen(Qt::NoPen);
-                    flash->setOpacity(0.0);
-                    flash->setZValue(999);
-                    battleScene->addItem(flash);
-
-                    auto *burst = new QVariantAnimation(this);
-                    burst->setDuration(200);
-                    burst->setStartValue(0.0);
-                    burst->setKeyValueAt(0.3, 0.8);
-                    burst->setEndValue(0.0);
-
-                    QObject::connect(burst, &QVariantAnimation::valueChanged,
-                                     [=](const QVariant &v) {
-                                         flash->setOpacity(v.toReal());
-                                     });
-
-                    QObject::connect(burst, &QVariantAnimation::finished,
-                                     [=]() {
-                                         battleScene->removeItem(flash);
-                                         delete flash;
-                                     });
-
-                    burst->start(QAbstractAnimation::DeleteWhenStopped);
+                    EffectSpec flash;
+                    flash.center = battlePlayerPokemonItem->pos();
+                    flash.startSize = 60;
+                    flash.endSize = 60;
+                    flash.durationMs = timeline.scaled(200);
+                    flash.peakAt = 0.3;
+                    flash.strength = 0.8;
+                    effects.spawn(flash);
                 }
 
                 // Enemy gets a turn
-                QTimer::singleShot(800, [=]() {
+                timeline.after(800, [=]() {
                     enemyTurn();
                 });
             });
@@ -1981,7 +1862,9 @@ void BattleSequence::attemptCatchPokemon(int itemIndex)
 
 void BattleSequence::onOpponentTurnComplete(int opponentMoveIndex, int damage)
 {
+    PROFILE_ZONE("battle.opponentTurn");
     if (!battleSystem || !battleSystem->getPvpMode()) return;
+    turnNumber++;
 
     // Only process if it's the opponent's turn
     if (isMyTurn) {
@@ -2048,13 +1931,13 @@ void BattleSequence::onOpponentTurnComplete(int opponentMoveIndex, int damage)
     startTextAnimation();
 
     // Play attack animation
-    QTimer::singleShot(500, [=]() {
+    timeline.after(500, [=]() {
         animations.animateAttackImpact(this, false);
     });
 
     // Execute opponent's move using precalculated damage
     // Capture enemyPoke pointer to access non-const moves inside lambda
-    QTimer::singleShot(1500, [=]() {
+    timeline.after(1000, [=]() {
         if (validOpponentMoveIndex >= 0 && enemyPoke) {
             auto& movesRef = enemyPoke->getMoves(); // Get non-const reference inside lambda
             if (validOpponentMoveIndex < static_cast<int>(movesRef.size())) {
@@ -2071,115 +1954,119 @@ void BattleSequence::onOpponentTurnComplete(int opponentMoveIndex, int damage)
 
         updateBattleUI();
 
-        // Check if player's Pokemon fainted - show message and handle switching
-        if (gamePlayer && gamePlayer->getActivePokemon() && gamePlayer->getActivePokemon()->isFainted()) {
-            QString faintedName = battleSystem->getPlayerPokemonName();
-            setBattleText(faintedName + " fainted!");
-            startTextAnimation();
+        // The rest waits until the HP bars have drained
+        afterHpBars([=]() {
+            // Check if player's Pokemon fainted - show message and handle switching
+            if (gamePlayer && gamePlayer->getActivePokemon() && gamePlayer->getActivePokemon()->isFainted()) {
+                QString faintedName = battleSystem->getPlayerPokemonName();
+                setBattleText(faintedName + " fainted!");
+                startTextAnimation();
 
-            // Check if player has usable Pokemon
-            std::vector<int> playerUsableIndices = gamePlayer->getUsablePokemonIndices();
-            if (playerUsableIndices.empty()) {
-                // Player has no usable Pokemon - send LOSE packet and end battle
-                if (uartComm) {
-                    BattlePacket losePacket(PacketType::LOSE);
-                    uartComm->sendPacket(losePacket);
-                }
+                // Check if player has usable Pokemon
+                std::vector<int> playerUsableIndices = gamePlayer->getUsablePokemonIndices();
+                if (playerUsableIndices.empty()) {
+                    // Player has no usable Pokemon - send LOSE packet and end battle
+                    if (uartComm) {
+                        BattlePacket losePacket(PacketType::LOSE);
+                        uartComm->sendPacket(losePacket);
+                    }
 
-                QTimer::singleShot(1500, [=]() {
-                    setBattleText("You have no Pokemon left!\nYou lost!");
-                    startTextAnimation();
+                    timeline.after(1500, [=]() {
+                        setBattleText("You have no Pokemon left!\nYou lost!");
+                        startTextAnimation();
 
-                    QTimer::singleShot(2000, [=]() {
-                        fadeOutBattleScreen([=]() {
-                            closeBattle();
+                        timeline.after(2000, [=]() {
+                            fadeOutBattleScreen([=]() {
+                                closeBattle();
+                            });
                         });
                     });
-                });
-                return;
-            }
+                    return;
+                }
 
-            // Player has usable Pokemon - auto-switch
-            QTimer::singleShot(1500, [=]() {
-                bool switched = checkAndAutoSwitchPokemon();
-                if (switched) {
-                    setBattleText("Go! " + battleSystem->getPlayerPokemonName() + "!");
-                    startTextAnimation();
+                // Player has usable Pokemon - auto-switch
+                timeline.after(1500, [=]() {
+                    bool switched = checkAndAutoSwitchPokemon();
+                    if (switched) {
+                        setBattleText("Go! " + battleSystem->getPlayerPokemonName() + "!");
+                        startTextAnimation();
 
-                    QTimer::singleShot(1500, [=]() {
-                        // Switch to player's turn after switching Pokemon
-                        isMyTurn = true;
-                        waitingForOpponent = false;
-                        battleSystem->setWaitingForOpponentTurn(false);
+                        timeline.after(1500, [=]() {
+                            // Switch to player's turn after switching Pokemon
+                            isMyTurn = true;
+                            waitingForOpponent = false;
+                            battleSystem->setWaitingForOpponentTurn(false);
 
-                        if (battle) {
-                            battle->returnToMainMenu();
-                        }
+                            if (battle) {
+                                battle->returnToMainMenu();
+                            }
 
-                        setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
-                        startTextAnimation();
+                            setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+                            startTextAnimation();
 
-                        inBattleMenu = true;
-                        battleMenuIndex = 0;
-                        updateBattleCursor();
-                        if (view) {
-                            view->setFocus();
-                        }
-                    });
-                }
-            });
-            return;
-        }
+                            inBattleMenu = true;
+                            battleMenuIndex = 0;
+                            updateBattleCursor();
+                            if (view) {
+                                view->setFocus();
+                            }
+                        });
+                    }
+                });
+                return;
+            }
 
-        // Check if battle ended
-        if (battleSystem->isBattleOver()) {
-            Player* winner = battleSystem->getWinner();
-            if (winner == gamePlayer) {
-                setBattleText("You won!");
-            } else {
-                // Player lost - check if all Pokemon are fainted and send LOSE packet
-                if (gamePlayer && gamePlayer->isDefeated() && uartComm) {
-                    BattlePacket losePacket(PacketType::LOSE);
-                    uartComm->sendPacket(losePacket);
+            // Check if battle ended
+            if (battleSystem->isBattleOver()) {
+                Player* winner = battleSystem->getWinner();
+                if (winner == gamePlayer) {
+                    setBattleText("You won!");
+                } else {
+                    // Player lost - check if all Pokemon are fainted and send LOSE packet
+                    if (gamePlayer && gamePlayer->isDefeated() && uartComm) {
+                        BattlePacket losePacket(PacketType::LOSE);
+                        uartComm->sendPacket(losePacket);
+                    }
+                    setBattleText("You lost!");
                 }
-                setBattleText("You lost!");
-            }
-            startTextAnimation();
+                startTextAnimation();
 
-            QTimer::singleShot(2000, [=]() {
-                fadeOutBattleScreen([=]() {
-                    closeBattle();
+                timeline.after(2000, [=]() {
+                    fadeOutBattleScreen([=]() {
+                        closeBattle();
+                    });
                 });
-            });
-            return;
-        }
+                return;
+            }
 
-        // Switch to player's turn
-        isMyTurn = true;
-        waitingForOpponent = false;
-        battleSystem->setWaitingForOpponentTurn(false);
+            // Switch to player's turn
+            isMyTurn = true;
+            waitingForOpponent = false;
+            battleSystem->setWaitingForOpponentTurn(false);
 
-        // Ensure battle state is back to MENU
-        if (battle) {
-            battle->returnToMainMenu();
-        }
+            // Ensure battle state is back to MENU
+            if (battle) {
+                battle->returnToMainMenu();
+            }
 
-        // Enable menu for player's turn
-        setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
-        startTextAnimation();
+            // Enable menu for player's turn
+            setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+            startTextAnimation();
 
-        inBattleMenu = true;
-        battleMenuIndex = 0;
-        updateBattleCursor();
-        if (view) {
-            view->setFocus();
-        }
+            inBattleMenu = true;
+            battleMenuIndex = 0;
+            updateBattleCursor();
+            if (view) {
+                view->setFocus();
+            }
+        });
     });
 }
 
 void BattleSequence::onOpponentItemUsed(int itemIndex, int healAmount)
 {
     if (!battleSystem || !battleSystem->getPvpMode()) return;
+    turnNumber++;
 
     // Apply healing to the opponent's active Pokemon on our side
     if (!enemyPlayer) return;
@@ -2229,7 +2116,7 @@ void BattleSequence::onOpponentItemUsed(int itemIndex, int healAmount)
         playerDamage = -1;
     }
 
-    QTimer::singleShot(1000, [=]() {
+    timeline.after(1000, [=]() {
         setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
         startTextAnimation();
         inBattleMenu = true;
@@ -2247,6 +2134,7 @@ void BattleSequence::onOpponentItemUsed(int itemIndex, int healAmount)
 void BattleSequence::onOpponentSwitched(int dexNumber, int level, int currentHP)
 {
     if (!battleSystem || !battleSystem->getPvpMode()) return;
+    turnNumber++;
 
     // Only process if it's the opponent's turn (they're switching)
     if (isMyTurn) {
@@ -2310,16 +2198,7 @@ void BattleSequence::onOpponentSwitched(int dexNumber, int level, int currentHP)
     if (battleEnemyItem) {
         const Pokemon* newActive = enemyPlayer->getActivePokemon();
         if (newActive) {
-            QString enemySpritePath = QString::fromStdString(newActive->getFrontSpritePath());
-            QPixmap enemyPx(enemySpritePath);
-            if (enemyPx.isNull()) {
-                QString spriteDir = QString::fromStdString(newActive->getSpriteDir());
-                enemySpritePath = ":/" + spriteDir + "/front.png";
-                enemyPx = QPixmap(enemySpritePath);
-            }
-            if (enemyPx.isNull()) {
-                enemyPx = QPixmap(":/Battle/assets/pokemon_sprites/006_charizard/front.png");
-            }
+            QPixmap enemyPx = SpriteCache::pokemon(newActive, true);
             if (!enemyPx.isNull()) {
                 float sx = 120.0f / enemyPx.width();
                 float sy = 120.0f / enemyPx.height();
@@ -2332,7 +2211,7 @@ void BattleSequence::onOpponentSwitched(int dexNumber, int level, int currentHP)
         }
     }
 
-    updateBattleUI();
+    updateBattleUI(false);
 
     QString enemyName = battleSystem->getEnemyPokemonName();
     if (enemyName.isEmpty()) {
@@ -2348,7 +2227,7 @@ void BattleSequence::onOpponentSwitched(int dexNumber, int level, int currentHP)
     waitingForOpponent = false;
     battleSystem->setWaitingForOpponentTurn(false);
 
-    QTimer::singleShot(1500, [=]() {
+    timeline.after(1500, [=]() {
         setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
         startTextAnimation();
         inBattleMenu = true;
@@ -2368,7 +2247,7 @@ void BattleSequence::onOpponentLost()
     setBattleText("Opponent has no Pokemon left!\nYou won!");
     startTextAnimation();
 
-    QTimer::singleShot(2000, [=]() {
+    timeline.after(2000, [=]() {
         fadeOutBattleScreen([=]() {
             closeBattle();
         });
@@ -2377,6 +2256,7 @@ void BattleSequence::onOpponentLost()
 
 void BattleSequence::executePvpTurn()
 {
+    PROFILE_ZONE("battle.pvpTurn");
     if (!battleSystem || !gamePlayer || !enemyPlayer) return;
 
     // Reset flags – we are now actively executing the turn
@@ -2423,12 +2303,12 @@ void BattleSequence::executePvpTurn()
     startTextAnimation();
 
     // Play attack animation
-    QTimer::singleShot(500, [=]() {
+    timeline.after(500, [=]() {
         animations.animateAttackImpact(this, true);
     });
 
     // Execute player's move using PRECALCULATED damage
-    QTimer::singleShot(1500, [=]() {
+    timeline.after(1000, [=]() {
         if (playerMoveIndex >= 0 && playerMoveIndex < static_cast<int>(playerPoke->getMoves().size())) {
             Attack& move = playerPoke->getMoves()[playerMoveIndex];
             if (move.canUse() && battle->checkAccuracyForPvp(move)) {
@@ -2442,83 +2322,86 @@ void BattleSequence::executePvpTurn()
 
         updateBattleUI();
 
-        // Check if enemy Pokemon fainted - show message and wait for SWITCH or LOSE packet
-        if (enemyPoke && enemyPoke->isFainted()) {
-            QString enemyName = battleSystem->getEnemyPokemonName();
-            if (enemyName.isEmpty()) {
-                enemyName = "The foe";
-            }
-            setBattleText(enemyName + " fainted!");
-            startTextAnimation();
-
-            // In PvP mode, don't decide battle outcome locally - wait for opponent's SWITCH or LOSE packet
-            // Reset state and wait for opponent's response
-            playerMoveIndex = -1;
-            playerDamage = -1;
-            playerMoveReady = false;
-            isMyTurn = false;  // Wait for opponent's turn (they'll send SWITCH or LOSE)
-            inBattleMenu = false;
-            QTimer::singleShot(1500, [=]() {
-                setBattleText("Waiting for opponent...");
-                startTextAnimation();
-            });
-            return;
-        }
-
-        // Check if battle ended (only for player's Pokemon fainting, not enemy's)
-        // Enemy fainting is handled above - we wait for SWITCH/LOSE packet
-        if (battleSystem->isBattleOver()) {
-            // Only end battle if player lost (all player Pokemon fainted)
-            Player* winner = battleSystem->getWinner();
-            if (winner != gamePlayer) {
-                // Player lost - check if all Pokemon are fainted and send LOSE packet
-                if (gamePlayer && gamePlayer->isDefeated() && uartComm) {
-                    BattlePacket losePacket(PacketType::LOSE);
-                    uartComm->sendPacket(losePacket);
+        // The rest waits until the HP bars have drained
+        afterHpBars([=]() {
+            // Check if enemy Pokemon fainted - show message and wait for SWITCH or LOSE packet
+            if (enemyPoke && enemyPoke->isFainted()) {
+                QString enemyName = battleSystem->getEnemyPokemonName();
+                if (enemyName.isEmpty()) {
+                    enemyName = "The foe";
                 }
-                setBattleText("You lost!");
+                setBattleText(enemyName + " fainted!");
                 startTextAnimation();
 
-                QTimer::singleShot(2000, [=]() {
-                    fadeOutBattleScreen([=]() {
-                        closeBattle();
-                    });
-                });
-
-                // Reset state
+                // In PvP mode, don't decide battle outcome locally - wait for opponent's SWITCH or LOSE packet
+                // Reset state and wait for opponent's response
                 playerMoveIndex = -1;
                 playerDamage = -1;
                 playerMoveReady = false;
-                if (view) {
-                    view->setFocus();
-                }
+                isMyTurn = false;  // Wait for opponent's turn (they'll send SWITCH or LOSE)
+                inBattleMenu = false;
+                timeline.after(1500, [=]() {
+                    setBattleText("Waiting for opponent...");
+                    startTextAnimation();
+                });
                 return;
             }
-            // If winner is gamePlayer, we should have already handled enemy fainting above
-            // and be waiting for SWITCH/LOSE packet, so this shouldn't happen
-        }
 
-        // Switch to opponent's turn
-        isMyTurn = false;
+            // Check if battle ended (only for player's Pokemon fainting, not enemy's)
+            // Enemy fainting is handled above - we wait for SWITCH/LOSE packet
+            if (battleSystem->isBattleOver()) {
+                // Only end battle if player lost (all player Pokemon fainted)
+                Player* winner = battleSystem->getWinner();
+                if (winner != gamePlayer) {
+                    // Player lost - check if all Pokemon are fainted and send LOSE packet
+                    if (gamePlayer && gamePlayer->isDefeated() && uartComm) {
+                        BattlePacket losePacket(PacketType::LOSE);
+                        uartComm->sendPacket(losePacket);
+                    }
+                    setBattleText("You lost!");
+                    startTextAnimation();
 
-        // Reset player's move state
-        playerMoveIndex = -1;
-        playerDamage = -1;
-        playerMoveReady = false;
+                    timeline.after(2000, [=]() {
+                        fadeOutBattleScreen([=]() {
+                            closeBattle();
+                        });
+                    });
 
-        // Ensure battle state is back to MENU
-        if (battle) {
-            battle->returnToMainMenu();
-        }
+                    // Reset state
+                    playerMoveIndex = -1;
+                    playerDamage = -1;
+                    playerMoveReady = false;
+                    if (view) {
+                        view->setFocus();
+                    }
+                    return;
+                }
+                // If winner is gamePlayer, we should have already handled enemy fainting above
+                // and be waiting for SWITCH/LOSE packet, so this shouldn't happen
+            }
 
-        // Show waiting message for opponent's turn
-        setBattleText("Waiting for opponent's turn...");
-        startTextAnimation();
+            // Switch to opponent's turn
+            isMyTurn = false;
 
-        inBattleMenu = false; // Disable menu while waiting for opponent
-        if (view) {
-            view->setFocus();
-        }
+            // Reset player's move state
+            playerMoveIndex = -1;
+            playerDamage = -1;
+            playerMoveReady = false;
+
+            // Ensure battle state is back to MENU
+            if (battle) {
+                battle->returnToMainMenu();
+            }
+
+            // Show waiting message for opponent's turn
+            setBattleText("Waiting for opponent's turn...");
+            startTextAnimation();
+
+            inBattleMenu = false; // Disable menu while waiting for opponent
+            if (view) {
+                view->setFocus();
+            }
+        });
     });
 }
 
@@ -2529,17 +2412,13 @@ void BattleSequence::setInitialTurnOrder(bool weGoFirst)
     // Update initial battle text based on turn order
     if (battleSystem && battleSystem->getPvpMode()) {
         if (isMyTurn) {
-            fullBattleText = "What will " + battleSystem->getPlayerPokemonName() + " do?";
+            setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
             inBattleMenu = true;
         } else {
-            fullBattleText = "Waiting for opponent's turn...";
+            setBattleText("Waiting for opponent's turn...");
             inBattleMenu = false;
         }
-        battleTextIndex = 0;
-        if (battleTextItem) {
-            battleTextItem->setPlainText("");
-        }
-        battleTextTimer.start(30);
+        startTextAnimation();
     }
 }
 
@@ -2609,7 +2488,7 @@ bool BattleSequence::checkAndAutoSwitchPokemon()
                               QString::number(newActive->getLevel()) + "," +
                               QString::number(newActive->getCurrentHP());
             BattlePacket switchPacket(PacketType::SWITCH, dataStr);
-            uartComm->sendPacket(switchPacket);
+            sendTurnPacket(switchPacket);
         }
     }
 
@@ -2617,16 +2496,7 @@ bool BattleSequence::checkAndAutoSwitchPokemon()
     if (battlePlayerPokemonItem) {
         const Pokemon* newActive = gamePlayer->getActivePokemon();
         if (newActive) {
-            QString playerSpritePath = QString::fromStdString(newActive->getBackSpritePath());
-            QPixmap playerPx(playerSpritePath);
-            if (playerPx.isNull()) {
-                QString spriteDir = QString::fromStdString(newActive->getSpriteDir());
-                playerSpritePath = ":/" + spriteDir + "/back.png";
-                playerPx = QPixmap(playerSpritePath);
-            }
-            if (playerPx.isNull()) {
-                playerPx = QPixmap(":/Battle/assets/pokemon_sprites/006_charizard/back.png");
-            }
+            QPixmap playerPx = SpriteCache::pokemon(newActive, false);
             if (!playerPx.isNull()) {
                 float sx = 140.0f / playerPx.width();
                 float sy = 140.0f / playerPx.height();
@@ -2639,6 +2509,218 @@ bool BattleSequence::checkAndAutoSwitchPokemon()
         }
     }
 
-    updateBattleUI();
+    updateBattleUI(false);
     return true; // Successfully switched
 }
+
+void BattleSequence::sendTurnPacket(const BattlePacket &packet)
+{
+    turnNumber++;
+    if (uartComm) {
+        uartComm->sendPacket(packet);
+    }
+}
+
+void BattleSequence::noteOpponentActivity()
+{
+    lastOpponentActivity.restart();
+}
+
+void BattleSequence::checkResyncWatchdog()
+{
+    if (!inBattle || !battleSystem || !battleSystem->getPvpMode() || !uartComm) return;
+
+    // Only a board that is idle and waiting on the opponent can be stuck
+    const bool waiting = !isMyTurn && !inBagMenu && !inPokemonMenu;
+    if (!waiting) {
+        waitingSince.invalidate();
+        return;
+    }
+    if (!waitingSince.isValid()) {
+        waitingSince.start();
+        return;
+    }
+
+    if (waitingSince.elapsed() >= resyncTimeoutMs && lastOpponentActivity.elapsed() >= resyncTimeoutMs) {
+        qDebug() << "No word from opponent for" << lastOpponentActivity.elapsed() << "ms, requesting resync";
+        requestResync();
+    }
+}
+
+void BattleSequence::requestResync()
+{
+    if (!inBattle || !battleSystem || !battleSystem->getPvpMode()) return;
+
+    sendResyncSummary(BattleSync_BT::SummaryKind::Request);
+
+    // Back off before asking again; fresh jitter keeps the boards out of step
+    waitingSince.restart();
+    resyncTimeoutMs = 6000 + QRandomGenerator::global()->bounded(3000);
+}
+
+void BattleSequence::sendResyncSummary(BattleSync_BT::SummaryKind kind)
+{
+    if (!uartComm || !gamePlayer || !enemyPlayer) return;
+
+    BattleSync_BT::Summary summary;
+    summary.turn = turnNumber;
+    summary.senderHasTurn = isMyTurn;
+    summary.ownHash = BattleSync_BT::hashTeam(*gamePlayer);
+    summary.enemyHash = BattleSync_BT::hashTeam(*enemyPlayer);
+    summary.kind = kind;
+    uartComm->sendPacket(BattlePacket(PacketType::RESYNC_HASH, BattleSync_BT::encodeSummary(summary)));
+}
+
+void BattleSequence::sendResyncState()
+{
+    if (!uartComm || !gamePlayer || !enemyPlayer) return;
+
+    QString data = BattleSync_BT::encodeState(turnNumber, isMyTurn, *gamePlayer, *enemyPlayer);
+    uartComm->sendPacket(BattlePacket(PacketType::RESYNC_STATE, data));
+    qDebug() << "Sent battle state for resync:" << data.size() << "bytes";
+}
+
+void BattleSequence::onResyncHash(const QString &data)
+{
+    if (!inBattle || !battleSystem || !battleSystem->getPvpMode() || !gamePlayer || !enemyPlayer) return;
+
+    BattleSync_BT::Summary theirs;
+    if (!BattleSync_BT::decodeSummary(data, &theirs)) {
+        qDebug() << "Malformed RESYNC_HASH:" << data;
+        return;
+    }
+
+    switch (theirs.kind) {
+        case BattleSync_BT::SummaryKind::InSync:
+            // Opponent is just taking their time
+            return;
+
+        case BattleSync_BT::SummaryKind::NeedState:
+            sendResyncState();
+            return;
+
+        case BattleSync_BT::SummaryKind::Request:
+            break;
+    }
+
+    // Only the receiver of a request decides, so the two boards can't disagree
+    const bool hashesMatch = theirs.ownHash == BattleSync_BT::hashTeam(*enemyPlayer)
+                             && theirs.enemyHash == BattleSync_BT::hashTeam(*gamePlayer);
+    const bool turnsMatch = theirs.turn == turnNumber && theirs.senderHasTurn != isMyTurn
+                            && hasReceivedTurnOrder;
+
+    if (hashesMatch && turnsMatch) {
+        sendResyncSummary(BattleSync_BT::SummaryKind::InSync);
+        return;
+    }
+
+    qDebug() << "Battle state diverged (turn" << turnNumber << "vs" << theirs.turn << "), resyncing";
+
+    // Whoever has seen more turns holds the packets the other side missed.
+    // On a tie we (the receiver) are authoritative.
+    if (theirs.turn > turnNumber) {
+        sendResyncSummary(BattleSync_BT::SummaryKind::NeedState);
+    } else {
+        if (!isMyTurn && !theirs.senderHasTurn) {
+            // Both boards were waiting (e.g. TURN_ORDER was lost); our state hands them the move
+            qDebug() << "Both sides waiting, handing the turn to the opponent";
+        } else if (isMyTurn && theirs.senderHasTurn) {
+            // Both thought they could move; keep it ourselves
+            qDebug() << "Both sides had the turn, keeping it";
+        }
+        sendResyncState();
+    }
+}
+
+void BattleSequence::onResyncState(const QString &data)
+{
+    if (!inBattle || !battleSystem || !battleSystem->getPvpMode() || !gamePlayer || !enemyPlayer) return;
+
+    int newTurn = turnNumber;
+    bool myTurn = isMyTurn;
+    if (!BattleSync_BT::applyState(data, *gamePlayer, *enemyPlayer, &newTurn, &myTurn)) {
+        qDebug() << "Malformed RESYNC_STATE:" << data;
+        return;
+    }
+
+    qDebug() << "Adopted opponent's battle state at turn" << newTurn;
+    turnNumber = newTurn;
+    isMyTurn = myTurn;
+    hasReceivedTurnOrder = true;
+    waitingForOpponent = false;
+    battleSystem->setWaitingForOpponentTurn(false);
+    playerMoveIndex = -1;
+    opponentMoveIndex = -1;
+    playerDamage = -1;
+    opponentDamage = -1;
+    playerMoveReady = false;
+    opponentMoveReady = false;
+    waitingSince.invalidate();
+
+    hideMoveMenu();
+    hideBagMenu();
+    hidePokemonMenu();
+    inBagMenu = false;
+    inPokemonMenu = false;
+
+    refreshPokemonSprites();
+    updateBattleUI(false);
+
+    if (gamePlayer->isDefeated()) {
+        if (uartComm) {
+            uartComm->sendPacket(BattlePacket(PacketType::LOSE));
+        }
+        setBattleText("You have no Pokemon left!\nYou lost!");
+        startTextAnimation();
+        timeline.after(2000, [=]() {
+            fadeOutBattleScreen([=]() {
+                closeBattle();
+            });
+        });
+        return;
+    }
+
+    Battle* battle = battleSystem->getBattle();
+    if (battle) {
+        battle->returnToMainMenu();
+    }
+
+    if (isMyTurn) {
+        setBattleText("What will " + battleSystem->getPlayerPokemonName() + " do?");
+        inBattleMenu = true;
+        battleMenuIndex = 0;
+    } else {
+        setBattleText("Waiting for opponent's turn...");
+        inBattleMenu = false;
+    }
+    startTextAnimation();
+    updateBattleCursor();
+    if (view) {
+        view->setFocus();
+    }
+}
+
+void BattleSequence::refreshPokemonSprites()
+{
+    const Pokemon *enemyActive = enemyPlayer ? enemyPlayer->getActivePokemon() : nullptr;
+    if (battleEnemyItem && enemyActive) {
+        QPixmap enemyPx = SpriteCache::pokemon(enemyActive, true);
+        if (!enemyPx.isNull()) {
+            float scale = std::min(120.0f / enemyPx.width(), 120.0f / enemyPx.height());
+            battleEnemyItem->setPixmap(enemyPx);
+            battleEnemyItem->setScale(scale);
+            battleEnemyItem->setPos(360, 272 - enemyPx.height() * scale - 80);
+        }
+    }
+
+    const Pokemon *playerActive = gamePlayer ? gamePlayer->getActivePokemon() : nullptr;
+    if (battlePlayerPokemonItem && playerActive) {
+        QPixmap playerPx = SpriteCache::pokemon(playerActive, false);
+        if (!playerPx.isNull()) {
+            float scale = std::min(140.0f / playerPx.width(), 140.0f / playerPx.height());
+            battlePlayerPokemonItem->setPixmap(playerPx);
+            battlePlayerPokemonItem->setScale(scale);
+            battlePlayerPokemonItem->setPos(60, 272 - playerPx.height() * scale - 50);
+        }
+    }
+}
@@ -14,28 +14,35 @@
 #include <QKeyEvent>
 #include <QTimer>
 #include <QVector>
+#include <QStringList>
+#include <QElapsedTimer>
 #include <functional>
 #include <QObject>
 #include "BattleState_BT.h"
 #include "Battle_logic/Player.h"
 #include "Animations_BT.h"
+#include "EffectPool_BT.h"
+#include "BattleTimeline_BT.h"
+#include "HpBar_BT.h"
+#include "BattleSync_BT.h"
 #include "../General/uart_comm.h"
+#include "../General/glyph_text.h"
 
 class BattleSequence : public QObject
 {
     Q_OBJECT
 
 public:
-    BattleSequence(QGraphicsScene *scene, QGraphicsView *view);
+    explicit BattleSequence(QGraphicsView *view);
     ~BattleSequence();
 
     // Battle initialization
     void startBattle(Player* player, Player* enemy, BattleSystem* battleSystem);
     void closeBattle();
 
-    // UI setup
+    // UI setup; the items are created once, when the battle scene is built
     void setupBattleUI();
-    void updateBattleUI();
+    void updateBattleUI(bool animateHp = true);  // false snaps the HP bars (new battle, switch)
 
     // Input handling
     void handleBattleKey(QKeyEvent *event);
@@ -62,11 +69,12 @@ public:
     // Getters
     bool isInBattle() const { return inBattle; }
     bool isInMenu() const { return inBattleMenu || inBagMenu || inPokemonMenu; }
-    QGraphicsScene* getScene() const { return battleScene; }
+    QGraphicsScene* getScene() const { return battleScene; }  // Owned by us, lives as long as we do
 
     // Text display
     void setBattleText(const QString &text);
     void startTextAnimation();
+    void finishTextAnimation();  // Show the whole message now
     
     // PvP support
     void setUartComm(UartComm* uart) { uartComm = uart; }
@@ -76,6 +84,12 @@ public:
     void onOpponentSwitched(int dexNumber, int level, int currentHP = -1);  // Called when SWITCH packet is received
     void onOpponentLost();                                     // Called when LOSE packet is received
 
+    // PvP recovery after a lost packet or link drop
+    void noteOpponentActivity();              // Any packet from the opponent arrived
+    void requestResync();                     // Send a RESYNC_HASH summary now
+    void onResyncHash(const QString &data);   // Called when RESYNC_HASH packet is received
+    void onResyncState(const QString &data);  // Called when RESYNC_STATE packet is received
+
 signals:
     void battleEnded();
 
@@ -85,6 +99,16 @@ private:
     QGraphicsScene *battleScene;
     QGraphicsView *view;
     Animations_BT animations;
+    EffectPool_BT effects;
+    BattleTimeline_BT timeline;   // Every delayed step of the intro and each turn
+
+    // The one 16 ms battle frame: drives the timeline, the effects, both
+    // HP bars and the text reveal, and stops when none of them has anything
+    // left to do
+    QTimer frameTimer;
+    void startFrames();
+    void onFrame();
+    void tickText();
 
     // Battle state
     bool inBattle = false;
@@ -104,6 +128,15 @@ private:
     bool opponentTurnComplete = false; // True when opponent has completed their turn (item or move)
     bool isMyTurn = false;          // True when it's the local player's turn (alternating turns)
     bool hasReceivedTurnOrder = false; // True when TURN_ORDER packet has been received (PvP only)
+    int turnNumber = 0;             // TURN/ITEM/SWITCH packets sent + received this battle
+
+    // Resync watchdog: if we've been waiting on the opponent with no traffic
+    // for resyncTimeoutMs (jittered so both boards don't fire together), ask
+    // for a state comparison.
+    QTimer resyncWatchdog;
+    QElapsedTimer lastOpponentActivity;
+    QElapsedTimer waitingSince;
+    int resyncTimeoutMs = 0;
 
     // Battle UI elements
     QGraphicsPixmapItem *battleTrainerItem = nullptr;
@@ -112,23 +145,24 @@ private:
 
     // HP bars
     QGraphicsRectItem *enemyHpBack = nullptr;
-    QGraphicsRectItem *enemyHpFill = nullptr;
     QGraphicsRectItem *playerHpBack = nullptr;
-    QGraphicsRectItem *playerHpFill = nullptr;
     QGraphicsPixmapItem *enemyHpBackSprite = nullptr;
     QGraphicsPixmapItem *playerHpBackSprite = nullptr;
     QGraphicsRectItem *enemyHpMask = nullptr;
     QGraphicsRectItem *playerHpMask = nullptr;
+    HpBar_BT enemyHpBar;
+    HpBar_BT playerHpBar;
 
     // Text elements
     QGraphicsTextItem *enemyPokemonNameText = nullptr;
     QGraphicsTextItem *playerPokemonNameText = nullptr;
     QGraphicsRectItem *battleTextBoxRect = nullptr;
-    QGraphicsTextItem *battleTextItem = nullptr;
+    GlyphTextItem *battleTextItem = nullptr;
     QGraphicsPixmapItem *dialogueBoxSprite = nullptr;
     QString fullBattleText;
     int battleTextIndex = 0;
-    QTimer battleTextTimer;
+    qint64 textStartMs = -1;   // Timeline clock when the reveal began; -1 when idle
+    int textStepMs = 0;        // Per character, at the speed the reveal started at
 
     // Menu system
     int battleMenuIndex = 0;
@@ -140,17 +174,25 @@ private:
     QGraphicsPixmapItem *battleCursorSprite = nullptr;
     QVector<QGraphicsTextItem*> battleMenuOptions;
 
+    // Move, bag and Pokemon menus are built once with the scene and shown or
+    // hidden as needed. The *MenuOptions vectors hold the labels in use.
+    struct MenuPanel {
+        QGraphicsRectItem *shadow = nullptr;
+        QGraphicsRectItem *box = nullptr;
+        QVector<QGraphicsTextItem*> labels;
+    };
+    MenuPanel movePanel;
+    MenuPanel bagPanel;
+    MenuPanel pokemonPanel;
+
     // Move menu
-    QGraphicsRectItem *moveMenuRect = nullptr;
     QVector<QGraphicsTextItem*> moveMenuOptions;
 
     // Bag menu
-    QGraphicsRectItem *bagMenuRect = nullptr;
     QVector<QGraphicsTextItem*> bagMenuOptions;
     QVector<int> bagMenuItemIndices; // Maps menu index to actual bag item index
 
     // Pokemon menu
-    QGraphicsRectItem *pokemonMenuRect = nullptr;
     QVector<QGraphicsTextItem*> pokemonMenuOptions;
 
     // Animation effects
@@ -162,15 +204,25 @@ private:
     QVariantAnimation *battleCircleAnim = nullptr;
 
     // Helper functions
-    void setHpColor(QGraphicsRectItem *hpBar, float hpPercent);
-    void destroyMoveMenu();
-    void destroyBagMenu();
-    void destroyPokemonMenu();
+    void buildBattleScene();   // Once, from the constructor
+    void resetBattleScene();   // Start of every battle
+    void buildMenuPanel(MenuPanel &panel, qreal boxH, qreal rowStep, int count);
+    void showMenuPanel(MenuPanel &panel, QVector<QGraphicsTextItem*> &options, const QStringList &labels);
+    void hideMenuPanel(MenuPanel &panel, QVector<QGraphicsTextItem*> &options);
+    void hideMoveMenu();
+    void hideBagMenu();
+    void hidePokemonMenu();
     QString capitalizeFirst(const QString& str) const;
     void attemptCatchPokemon(int itemIndex);
     bool checkAndAutoSwitchPokemon(); // Returns true if switched, false if no Pokemon available
     void executePvpTurn(); // Execute a single move for PvP (alternating turns)
     void determineInitialTurnOrder(); // Determine who goes first based on speed stats
+    void sendTurnPacket(const BattlePacket &packet); // Send TURN/ITEM/SWITCH and count the turn
+    void checkResyncWatchdog();
+    void sendResyncSummary(BattleSync_BT::SummaryKind kind);
+    void sendResyncState();
+    void refreshPokemonSprites();
+    void afterHpBars(const BattleTimeline_BT::Action &next);  // Queue next for once both bars stop
 
     friend class Animations_BT;
 };
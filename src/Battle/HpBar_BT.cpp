@@ -0,0 +1,169 @@
+#include "HpBar_BT.h"
+#include <QGraphicsScene>
+#include <QGraphicsRectItem>
+#include <QBrush>
+#include <QPen>
+
+HpBar_BT::HpBar_BT(QObject *parent)
+    : QObject(parent)
+{
+    clock.start();
+}
+
+const QBrush& HpBar_BT::brush(Band band)
+{
+    static const QBrush green(QColor("#3CD75F"));
+    static const QBrush yellow(QColor("#FFCB43"));
+    static const QBrush red(QColor("#FF4949"));
+
+    switch (band) {
+    case Green:  return green;
+    case Yellow: return yellow;
+    default:     return red;
+    }
+}
+
+void HpBar_BT::attach(QGraphicsScene *scene, const QPointF &pos, int width, int h, qreal z)
+{
+    if (!scene || fill) return;
+
+    fullWidth = width;
+    height = h;
+
+    fill = new QGraphicsRectItem(0, 0, fullWidth, height);
+    fill->setBrush(brush(Green));
+    fill->setPen(Qt::NoPen);
+    fill->setPos(pos);
+    fill->setZValue(z);
+    scene->addItem(fill);
+
+    shownWidth = fullWidth;
+    shownBand = Green;
+    steps.reserve(fullWidth / kPixelsPerStep + 1);
+}
+
+int HpBar_BT::widthFor(int hp, int maxHp) const
+{
+    if (maxHp <= 0 || hp <= 0) return 0;
+    if (hp >= maxHp) return fullWidth;
+
+    // Any HP left shows at least one pixel
+    return qMax(1, fullWidth * hp / maxHp);
+}
+
+HpBar_BT::Band HpBar_BT::bandFor(int width) const
+{
+    // Same thresholds as before: above half green, above a fifth yellow
+    if (width * 2 > fullWidth) return Green;
+    if (width * 5 > fullWidth) return Yellow;
+    return Red;
+}
+
+void HpBar_BT::show(int width)
+{
+    if (width == shownWidth) return;
+
+    shownWidth = width;
+    fill->setRect(0, 0, width, height);
+
+    const Band band = bandFor(width);
+    if (band != shownBand) {
+        shownBand = band;
+        fill->setBrush(brush(band));
+    }
+}
+
+void HpBar_BT::setHp(int hp, int maxHp)
+{
+    if (!fill) return;
+
+    animating = false;
+    steps.resize(0);
+    show(widthFor(hp, maxHp));
+    finish();
+}
+
+void HpBar_BT::animateTo(int hp, int maxHp, int msPerStep, std::function<void()> onFinished)
+{
+    if (!fill) {
+        if (onFinished) onFinished();
+        return;
+    }
+
+    const int target = widthFor(hp, maxHp);
+    if (isAnimating() && msPerStep > 0 && steps.last() == target) {
+        // Already heading there
+        whenStopped(onFinished);
+        return;
+    }
+
+    // A newer change takes over from one still running
+    animating = false;
+    finish();
+    finished = onFinished;
+
+    if (msPerStep <= 0 || target == shownWidth) {
+        show(target);
+        finish();
+        return;
+    }
+
+    // resize(0) keeps the reserved capacity, so this doesn't allocate
+    steps.resize(0);
+    const int dir = target < shownWidth ? -1 : 1;
+    for (int w = shownWidth + dir * kPixelsPerStep; dir * (target - w) > 0; w += dir * kPixelsPerStep) {
+        steps.append(w);
+    }
+    steps.append(target);
+    nextStep = 0;
+
+    stepMs = msPerStep;
+    startMs = clock.elapsed();
+    animating = true;
+    emit framesNeeded();
+}
+
+void HpBar_BT::whenStopped(std::function<void()> callback)
+{
+    if (!callback) return;
+    if (!isAnimating()) {
+        callback();
+        return;
+    }
+
+    if (!finished) {
+        finished = callback;
+        return;
+    }
+    std::function<void()> previous = finished;
+    finished = [previous, callback]() {
+        previous();
+        callback();
+    };
+}
+
+void HpBar_BT::tick()
+{
+    if (!animating) return;
+
+    // Faster than one step a frame (2x, 4x) shows only the latest step due
+    const int due = qMin<qint64>(steps.size(), (clock.elapsed() - startMs) / stepMs);
+    if (due <= nextStep) return;
+
+    nextStep = due;
+    show(steps[nextStep - 1]);
+    if (nextStep >= steps.size()) {
+        animating = false;
+        finish();
+    }
+}
+
+void HpBar_BT::finish()
+{
+    if (!finished) return;
+
+    // Cleared first: the callback may start another drain
+    std::function<void()> callback = finished;
+    finished = nullptr;
+    callback();
+}
@@ -0,0 +1,74 @@
+#ifndef HPBAR_BT_H
+#define HPBAR_BT_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QPointF>
+#include <functional>
+
+class QGraphicsScene;
+class QGraphicsRectItem;
+class QBrush;
+
+// The coloured fill of one HP bar. A change in HP drains (or fills) the bar
+// a fixed number of pixels per step, like the Gen 3 games. The widths for
+// every step are worked out up front, so each step only sets the fill's
+// width, plus its brush when the colour band changes. The three brushes
+// are built once and shared by both bars.
+class HpBar_BT : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HpBar_BT(QObject *parent = nullptr);
+
+    // Create the fill item in the scene. Call once.
+    void attach(QGraphicsScene *scene, const QPointF &pos, int fullWidth, int height, qreal z);
+
+    // Jump straight to a value (new battle, switch, resync)
+    void setHp(int hp, int maxHp);
+
+    // Move to a value one step every msPerStep; 0 jumps. onFinished runs
+    // once the bar has stopped, or straight away if it is already there.
+    void animateTo(int hp, int maxHp, int msPerStep, std::function<void()> onFinished = nullptr);
+
+    bool isAnimating() const { return animating; }
+
+    // Called every battle frame while animating: shows the steps that are due
+    void tick();
+
+    // Run callback once the current change is done (now, if there isn't one)
+    void whenStopped(std::function<void()> callback);
+
+signals:
+    // A drain started; the owner should start calling tick()
+    void framesNeeded();
+
+private:
+    enum Band { Green, Yellow, Red };
+
+    static constexpr int kPixelsPerStep = 2;
+
+    static const QBrush& brush(Band band);
+    int widthFor(int hp, int maxHp) const;
+    Band bandFor(int width) const;
+    void show(int width);
+    void finish();
+
+    QGraphicsRectItem *fill = nullptr;
+    int fullWidth = 0;
+    int height = 0;
+    int shownWidth = -1;
+    Band shownBand = Green;
+
+    QVector<int> steps;        // Widths still to show, in order
+    int nextStep = 0;
+    int stepMs = 0;
+    qint64 startMs = 0;        // When the first step was due to start
+    bool animating = false;
+    QElapsedTimer clock;
+    std::function<void()> finished;
+};
+
+#endif // HPBAR_BT_H
@@ -0,0 +1,113 @@
+#include "SpriteAtlas_BT.h"
+#include "Battle_logic/Pokemon.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QVector>
+
+static const char *kAtlasIndex = ":/Battle/assets/atlas/pokemon_atlas.json";
+static const int kFallbackDex = 6;  // Charizard, for anything the atlas doesn't list
+
+SpriteAtlas_BT::Atlas SpriteAtlas_BT::loadAtlas(const QString &indexPath)
+{
+    Atlas result;
+
+    QFile file(indexPath);
+    if (!file.exists()) {
+        qDebug() << "No sprite atlas at" << indexPath << "- Pokemon sprites will be missing";
+        return result;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Cannot open sprite atlas index:" << indexPath;
+        return result;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (doc.isNull()) {
+        qDebug() << "Sprite atlas index" << indexPath << "is not valid JSON:" << error.errorString();
+        return result;
+    }
+
+    const QDir base = QFileInfo(indexPath).absoluteDir();
+    const QJsonObject root = doc.object();
+
+    for (const QJsonValue &value : root.value("pages").toArray()) {
+        QPixmap page(base.filePath(value.toString()));
+        if (page.isNull()) {
+            qDebug() << "Sprite atlas page" << value.toString() << "failed to load";
+            result.pages.clear();
+            return result;
+        }
+        result.pages.append(page);
+    }
+
+    const QJsonObject sprites = root.value("sprites").toObject();
+    for (auto it = sprites.constBegin(); it != sprites.constEnd(); ++it) {
+        // "<dex>/<front|back>": [page, x, y, width, height]
+        const QString name = it.key();
+        const int slash = name.indexOf('/');
+        const QJsonArray entry = it.value().toArray();
+        if (slash < 0 || entry.size() != 5) continue;
+
+        const int dex = name.left(slash).toInt();
+        const bool front = name.mid(slash + 1) == "front";
+        const int page = entry.at(0).toInt();
+        if (page < 0 || page >= result.pages.size()) continue;
+
+        QRect rect(entry.at(1).toInt(), entry.at(2).toInt(), entry.at(3).toInt(), entry.at(4).toInt());
+        result.rects.insert(key(dex, front), qMakePair(page, rect));
+    }
+
+    result.loaded = !result.pages.isEmpty();
+    qDebug() << "Sprite atlas:" << result.rects.size() << "sprites on" << result.pages.size() << "page(s)";
+    return result;
+}
+
+const SpriteAtlas_BT::Atlas& SpriteAtlas_BT::atlas()
+{
+    static Atlas cached = []() {
+        // Outlives QApplication, but the pixmaps in it must not
+        if (QCoreApplication *app = QCoreApplication::instance()) {
+            QObject::connect(app, &QCoreApplication::aboutToQuit, []() { cached.pages.clear(); });
+        }
+        return loadAtlas(kAtlasIndex);
+    }();
+    return cached;
+}
+
+bool SpriteAtlas_BT::isLoaded()
+{
+    return atlas().loaded;
+}
+
+QPixmap SpriteAtlas_BT::fromAtlas(int dexNumber, bool front)
+{
+    const Atlas &a = atlas();
+    auto it = a.rects.constFind(key(dexNumber, front));
+    if (it == a.rects.constEnd() || it->first >= a.pages.size()) {
+        return QPixmap();
+    }
+    // A fresh copy that the caller (SpriteCache) owns; only the pages stay here
+    return a.pages.at(it->first).copy(it->second);
+}
+
+QPixmap SpriteAtlas_BT::sprite(int dexNumber, bool front)
+{
+    QPixmap px = fromAtlas(dexNumber, front);
+    if (px.isNull()) {
+        qDebug() << "No atlas sprite for dex" << dexNumber << (front ? "front" : "back");
+        px = fromAtlas(kFallbackDex, front);
+    }
+    return px;
+}
+
+QPixmap SpriteAtlas_BT::sprite(const Pokemon *pokemon, bool front)
+{
+    return sprite(pokemon ? pokemon->getDexNumber() : kFallbackDex, front);
+}
@@ -0,0 +1,40 @@
+#ifndef SPRITEATLAS_BT_H
+#define SPRITEATLAS_BT_H
+
+#include <QPixmap>
+#include <QHash>
+#include <QVector>
+#include <QRect>
+
+class Pokemon;
+
+// Battle sprites packed by pack_sprite_atlas.py. The atlas pages are decoded
+// once, on first use, and are the only pixmaps kept here. Each lookup copies
+// one sprite out of a page; SpriteCache owns that copy, so only the sprites
+// it holds are resident on top of the pages. Lookups are made on a cache
+// miss, not per frame.
+//
+// A sprite the atlas doesn't list falls back to Charizard's.
+class SpriteAtlas_BT
+{
+public:
+    static QPixmap sprite(const Pokemon *pokemon, bool front);
+    static QPixmap sprite(int dexNumber, bool front);
+
+    // True when the atlas index and all of its pages loaded
+    static bool isLoaded();
+
+private:
+    struct Atlas {
+        QVector<QPixmap> pages;
+        QHash<int, QPair<int, QRect>> rects;  // key(dex, front) -> (page, rect)
+        bool loaded = false;
+    };
+
+    static int key(int dexNumber, bool front) { return dexNumber * 2 + (front ? 1 : 0); }
+    static const Atlas& atlas();
+    static Atlas loadAtlas(const QString &indexPath);
+    static QPixmap fromAtlas(int dexNumber, bool front);
+};
+
+#endif // SPRITEATLAS_BT_H
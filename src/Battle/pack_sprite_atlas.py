@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+Script to pack the Pokemon front/back sprites into texture atlases for
+SpriteAtlas_BT. Every "NNN_name/front.png" and "NNN_name/back.png" under the
+sprite folder is placed on a grid of fixed-size cells (sprites smaller than a
+cell are centred on its bottom edge, like the battle scene draws them), and
+pages are started as needed so no atlas exceeds the maximum size.
+
+Writes pokemon_atlas_<page>.png and pokemon_atlas.json into the output
+directory. The index maps "<dex>/front" and "<dex>/back" to
+[page, x, y, width, height]. Add the files to assets.qrc afterwards.
+
+Usage: pack_sprite_atlas.py Battle/assets/pokemon_sprites Battle/assets/atlas
+"""
+
+import json
+import os
+import re
+import sys
+
+from PIL import Image
+
+MAX_ATLAS_SIZE = 2048  # Safe texture size on the board's GPU and in QPixmap
+FACINGS = ("front", "back")
+
+def collect_sprites(sprite_dir):
+    """Return [(dex, facing, image)] for every sprite folder, sorted by dex."""
+
+    sprites = []
+    for folder in sorted(os.listdir(sprite_dir)):
+        match = re.match(r"^(\d+)_", folder)
+        if not match:
+            continue
+        dex = int(match.group(1))
+        for facing in FACINGS:
+            path = os.path.join(sprite_dir, folder, f"{facing}.png")
+            if os.path.exists(path):
+                sprites.append((dex, facing, Image.open(path).convert("RGBA")))
+            else:
+                print(f"Warning: {path} is missing")
+    return sprites
+
+def pack_sprite_atlas(sprite_dir, output_dir):
+    """Pack all sprites into as few atlas pages as fit MAX_ATLAS_SIZE."""
+
+    sprites = collect_sprites(sprite_dir)
+    if not sprites:
+        print(f"No sprites found in {sprite_dir}")
+        return False
+
+    cell_w = max(image.width for _, _, image in sprites)
+    cell_h = max(image.height for _, _, image in sprites)
+    cols = max(1, MAX_ATLAS_SIZE // cell_w)
+    rows_per_page = max(1, MAX_ATLAS_SIZE // cell_h)
+    per_page = cols * rows_per_page
+
+    os.makedirs(output_dir, exist_ok=True)
+    index = {"cell": [cell_w, cell_h], "pages": [], "sprites": {}}
+
+    for page, start in enumerate(range(0, len(sprites), per_page)):
+        batch = sprites[start:start + per_page]
+        rows = (len(batch) + cols - 1) // cols
+        width = min(len(batch), cols) * cell_w
+        atlas = Image.new("RGBA", (width, rows * cell_h), (0, 0, 0, 0))
+
+        for i, (dex, facing, image) in enumerate(batch):
+            x = (i % cols) * cell_w + (cell_w - image.width) // 2
+            y = (i // cols) * cell_h + (cell_h - image.height)
+            atlas.paste(image, (x, y))
+            index["sprites"][f"{dex}/{facing}"] = [page, x, y, image.width, image.height]
+
+        name = f"pokemon_atlas_{page}.png"
+        atlas.save(os.path.join(output_dir, name), optimize=True)
+        index["pages"].append(name)
+        print(f"Wrote {name}: {len(batch)} sprites, {atlas.width}x{atlas.height}")
+
+    with open(os.path.join(output_dir, "pokemon_atlas.json"), "w") as f:
+        json.dump(index, f, indent=1, sort_keys=True)
+
+    print(f"Packed {len(sprites)} sprites into {len(index['pages'])} page(s)")
+    return True
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+    sys.exit(0 if pack_sprite_atlas(sys.argv[1], sys.argv[2]) else 1)
@@ -0,0 +1,372 @@
+#include "frame_profiler.h"
+
+#ifdef POKELITE_PROFILE
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+#include <QHash>
+#include <QEvent>
+#include <QKeyEvent>
+#include <QPainter>
+#include <QFontMetrics>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QDebug>
+#include <algorithm>
+#include "sprite_cache.h"
+#include <limits>
+
+namespace {
+
+// Names of the events the profiler records itself
+const char *const kFrame = "frame";
+const char *const kInput = "input latency";
+const char *const kTimers = "timers";
+
+// Counts timer events and notes key presses for every object in the app
+class ProfilerEventFilter : public QObject
+{
+public:
+    using QObject::QObject;
+
+    bool eventFilter(QObject *obj, QEvent *event) override
+    {
+        if (event->type() == QEvent::Timer) {
+            FrameProfiler::timerFired();
+        } else if (event->type() == QEvent::KeyPress &&
+                   !static_cast<QKeyEvent*>(event)->isAutoRepeat()) {
+            FrameProfiler::inputMark();
+        }
+        return QObject::eventFilter(obj, event);
+    }
+};
+
+} // namespace
+
+// ================================================
+// FrameProfiler
+// ================================================
+
+struct FrameProfiler::State
+{
+    struct Event {
+        const char *name = nullptr;
+        qint64 startNs = 0;
+        qint64 durationNs = 0;   // Value for counters
+        quintptr thread = 0;
+        bool counter = false;
+    };
+
+    // About a minute of play at a few dozen zones a frame; allocated once
+    static constexpr int kCapacity = 1 << 16;
+
+    QMutex mutex;            // The link I/O thread records too
+    QVector<Event> ring;
+    int head = 0;            // Next slot to write
+    bool wrapped = false;
+
+    QElapsedTimer clock;
+    quintptr mainThread = 0;
+
+    // GUI thread only
+    qint64 lastFrameNs = -1;
+    qint64 pendingInputNs = -1;
+    int timersThisFrame = 0;
+
+    State()
+    {
+        ring.resize(kCapacity);
+        clock.start();
+    }
+
+    void push(const Event &event)
+    {
+        QMutexLocker locker(&mutex);
+        ring[head] = event;
+        if (++head == kCapacity) {
+            head = 0;
+            wrapped = true;
+        }
+    }
+
+    // Events that ended at or after sinceNs, oldest first. Events are pushed
+    // when they end, so this walks back from head and stops at the first
+    // older one; the overlay copies a second's worth, not the whole ring.
+    QVector<Event> snapshot(qint64 sinceNs = std::numeric_limits<qint64>::min())
+    {
+        QMutexLocker locker(&mutex);
+        const int stored = wrapped ? kCapacity : head;
+        QVector<Event> events;
+        for (int n = 0, i = head; n < stored; ++n) {
+            i = (i == 0 ? kCapacity : i) - 1;
+            const Event &e = ring.at(i);
+            const qint64 endNs = e.counter ? e.startNs : e.startNs + e.durationNs;
+            if (endNs < sinceNs) break;
+            events.append(e);
+        }
+        std::reverse(events.begin(), events.end());
+        return events;
+    }
+};
+
+FrameProfiler::State& FrameProfiler::state()
+{
+    static State instance;
+    return instance;
+}
+
+qint64 FrameProfiler::nowNs()
+{
+    return state().clock.nsecsElapsed();
+}
+
+void FrameProfiler::install()
+{
+    State &s = state();
+    if (s.mainThread) return;
+
+    s.mainThread = quintptr(QThread::currentThreadId());
+    qApp->installEventFilter(new ProfilerEventFilter(qApp));
+    qDebug() << "Frame profiler on (F3 or START+SELECT for the overlay)";
+}
+
+void FrameProfiler::record(const char *name, qint64 startNs, qint64 durationNs)
+{
+    State::Event event;
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = durationNs;
+    event.thread = quintptr(QThread::currentThreadId());
+    state().push(event);
+}
+
+void FrameProfiler::inputMark()
+{
+    State &s = state();
+    // Latency is measured from the oldest input the next frame answers
+    if (s.pendingInputNs < 0) {
+        s.pendingInputNs = nowNs();
+    }
+}
+
+void FrameProfiler::timerFired()
+{
+    ++state().timersThisFrame;
+}
+
+void FrameProfiler::frameMark()
+{
+    State &s = state();
+    const qint64 now = nowNs();
+
+    if (s.lastFrameNs >= 0) {
+        record(kFrame, s.lastFrameNs, now - s.lastFrameNs);
+
+        State::Event timers;
+        timers.name = kTimers;
+        timers.startNs = now;
+        timers.durationNs = s.timersThisFrame;
+        timers.thread = s.mainThread;
+        timers.counter = true;
+        s.push(timers);
+    }
+    if (s.pendingInputNs >= 0) {
+        record(kInput, s.pendingInputNs, now - s.pendingInputNs);
+        s.pendingInputNs = -1;
+    }
+
+    s.lastFrameNs = now;
+    s.timersThisFrame = 0;
+}
+
+QStringList FrameProfiler::summary()
+{
+    struct Totals {
+        qint64 sumNs = 0;
+        qint64 maxNs = 0;
+        int count = 0;
+    };
+
+    const qint64 since = nowNs() - 1000000000LL;
+    const QVector<State::Event> events = state().snapshot(since);
+
+    QHash<const char*, Totals> zones;
+    Totals frames;
+    Totals input;
+    Totals timers;
+    for (const State::Event &e : events) {
+        if (e.startNs < since) continue;
+
+        Totals *t;
+        if (e.name == kFrame) t = &frames;
+        else if (e.name == kInput) t = &input;
+        else if (e.name == kTimers) t = &timers;
+        else t = &zones[e.name];
+
+        t->sumNs += e.durationNs;
+        t->maxNs = qMax(t->maxNs, e.durationNs);
+        ++t->count;
+    }
+
+    auto ms = [](qint64 ns) { return QString::number(ns / 1e6, 'f', 2); };
+    const int frameCount = qMax(1, frames.count);
+
+    QStringList lines;
+    lines << QString("%1 fps  frame %2 ms avg  %3 max")
+                 .arg(frames.count)
+                 .arg(ms(frames.sumNs / frameCount), ms(frames.maxNs));
+    lines << QString("input %1 ms avg  %2 max")
+                 .arg(input.count ? ms(input.sumNs / input.count) : QString("-"),
+                      input.count ? ms(input.maxNs) : QString("-"));
+    lines << QString("timers %1 per frame")
+                 .arg(QString::number(double(timers.sumNs) / frameCount, 'f', 1));
+    lines << QString("sprites %1  %2/%3 KB  %4 hits %5 misses")
+                 .arg(SpriteCache::count())
+                 .arg(SpriteCache::usedKb())
+                 .arg(SpriteCache::budgetKb())
+                 .arg(SpriteCache::hits())
+                 .arg(SpriteCache::misses());
+
+    // Heaviest zones first, as time per frame
+    QVector<const char*> names = zones.keys().toVector();
+    std::sort(names.begin(), names.end(), [&zones](const char *a, const char *b) {
+        return zones[a].sumNs > zones[b].sumNs;
+    });
+    for (int i = 0; i < names.size() && i < 8; ++i) {
+        const Totals &t = zones[names[i]];
+        lines << QString("%1 %2 ms/f  %3 max  x%4")
+                     .arg(QString::fromLatin1(names[i]), -18)
+                     .arg(ms(t.sumNs / frameCount), ms(t.maxNs))
+                     .arg(t.count);
+    }
+    return lines;
+}
+
+bool FrameProfiler::exportChromeTrace(const QString &path)
+{
+    State &s = state();
+    const QVector<State::Event> events = s.snapshot();
+
+    // Chrome wants small thread ids; the GUI thread is 1
+    QHash<quintptr, int> threadIds;
+    threadIds.insert(s.mainThread, 1);
+
+    QJsonArray trace;
+    for (const State::Event &e : events) {
+        if (!threadIds.contains(e.thread)) {
+            threadIds.insert(e.thread, threadIds.size() + 1);
+        }
+
+        QJsonObject object;
+        object["name"] = QString::fromLatin1(e.name);
+        object["pid"] = 1;
+        object["tid"] = threadIds.value(e.thread);
+        object["ts"] = e.startNs / 1000.0;
+        if (e.counter) {
+            object["ph"] = "C";
+            object["args"] = QJsonObject{{"count", double(e.durationNs)}};
+        } else {
+            object["ph"] = "X";
+            object["dur"] = e.durationNs / 1000.0;
+        }
+        trace.append(object);
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Could not write trace to" << path;
+        return false;
+    }
+    QJsonObject root;
+    root["traceEvents"] = trace;
+    root["displayTimeUnit"] = "ms";
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+
+    qDebug() << "Wrote" << events.size() << "trace events to" << path;
+    return true;
+}
+
+// ================================================
+// FrameProfiler::Zone
+// ================================================
+
+FrameProfiler::Zone::Zone(const char *zoneName)
+    : name(zoneName), startNs(FrameProfiler::nowNs())
+{
+}
+
+FrameProfiler::Zone::~Zone()
+{
+    FrameProfiler::record(name, startNs, FrameProfiler::nowNs() - startNs);
+}
+
+// ================================================
+// FrameProfilerOverlay
+// ================================================
+
+FrameProfilerOverlay::FrameProfilerOverlay(QWidget *parent)
+    : QWidget(parent)
+{
+    // Opaque, so refreshing it doesn't repaint the game view underneath
+    // and show up in the numbers it is reporting
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+
+    QFont mono("Monospace", 7);
+    mono.setStyleHint(QFont::TypeWriter);
+    setFont(mono);
+
+    refreshTimer.setInterval(500);
+    connect(&refreshTimer, &QTimer::timeout, this, [this]() {
+        lines = FrameProfiler::summary();
+        const QFontMetrics fm(font());
+        int w = 0;
+        for (const QString &line : lines) {
+            w = qMax(w, fm.horizontalAdvance(line));
+        }
+        setGeometry(4, 4, w + 8, lines.size() * fm.lineSpacing() + 6);
+        update();
+    });
+
+    hide();
+}
+
+void FrameProfilerOverlay::toggle()
+{
+    if (isVisible()) {
+        refreshTimer.stop();
+        hide();
+        return;
+    }
+
+    lines = QStringList{"profiling..."};
+    setGeometry(4, 4, 120, fontMetrics().lineSpacing() + 6);
+    show();
+    raise();
+    refreshTimer.start();
+}
+
+void FrameProfilerOverlay::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(16, 16, 16));
+    painter.setPen(QColor(120, 255, 120));
+
+    const QFontMetrics fm(font());
+    int y = 3 + fm.ascent();
+    for (const QString &line : lines) {
+        painter.drawText(4, y, line);
+        y += fm.lineSpacing();
+    }
+}
+
+#endif // POKELITE_PROFILE
@@ -0,0 +1,92 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+// Where the 16 ms frame goes. Scoped zones (PROFILE_ZONE) record how long
+// each subsystem takes into a ring buffer; the view marks every painted
+// frame (PROFILE_FRAME). An application-wide event filter adds input latency
+// (key press to the next painted frame) and the number of timer events per
+// frame. F3, or holding START and pressing SELECT, shows an overlay with the
+// last second, and POKELITE_TRACE=<file> writes the ring buffer out as
+// Chrome trace JSON (chrome://tracing, Perfetto) when the game exits.
+//
+// Only built with POKELITE_PROFILE defined (debug builds, or
+// qmake CONFIG+=profile). Otherwise the macros expand to nothing.
+
+#ifdef POKELITE_PROFILE
+
+#include <QObject>
+#include <QWidget>
+#include <QTimer>
+#include <QString>
+#include <QStringList>
+
+class FrameProfiler
+{
+public:
+    // Times the enclosing scope. name must be a string literal.
+    class Zone
+    {
+    public:
+        explicit Zone(const char *name);
+        ~Zone();
+
+    private:
+        const char *name;
+        qint64 startNs;
+    };
+
+    // Filter application events for input latency and timer counts; once, at startup
+    static void install();
+
+    // Called by the view at the start of every paint
+    static void frameMark();
+
+    // Input that the next frame should answer. Key presses are seen by the
+    // event filter; gamepad input arrives as a signal and calls this itself.
+    static void inputMark();
+    static void timerFired();
+
+    static void record(const char *name, qint64 startNs, qint64 durationNs);
+    static qint64 nowNs();
+
+    // Summary of the last second, one line per entry, for the overlay
+    static QStringList summary();
+
+    static bool exportChromeTrace(const QString &path);
+
+private:
+    struct State;
+    static State& state();
+};
+
+// Text box in the top-left corner that repaints the summary twice a second
+class FrameProfilerOverlay : public QWidget
+{
+public:
+    explicit FrameProfilerOverlay(QWidget *parent = nullptr);
+
+    void toggle();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    QTimer refreshTimer;
+    QStringList lines;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) FrameProfiler::Zone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_FRAME() FrameProfiler::frameMark()
+#define PROFILE_INPUT() FrameProfiler::inputMark()
+
+#else
+
+#define PROFILE_ZONE(name) do {} while (0)
+#define PROFILE_FRAME() do {} while (0)
+#define PROFILE_INPUT() do {} while (0)
+
+#endif // POKELITE_PROFILE
+
+#endif // FRAME_PROFILER_H
@@ -0,0 +1,264 @@
+#include "framebuffer_renderer.h"
+#include "game_view.h"
+#include "frame_profiler.h"
+#include <QDebug>
+#include <QPainter>
+#include <QScrollBar>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <linux/fb.h>
+
+// Size of the fake framebuffer file (the game's native resolution)
+static const int kFakeWidth = 480;
+static const int kFakeHeight = 272;
+
+FramebufferRenderer::FramebufferRenderer(GameView *view, QObject *parent)
+    : QObject(parent), view(view)
+{
+    // Fires once the current batch of scene and camera updates is done
+    frameTimer.setSingleShot(true);
+    frameTimer.setInterval(0);
+    connect(&frameTimer, &QTimer::timeout, this, &FramebufferRenderer::onFrameTimer);
+
+    if (view) {
+        // The camera moves the view with centerOn(), which scrolls
+        connect(view->horizontalScrollBar(), &QScrollBar::valueChanged, this, &FramebufferRenderer::onCameraMoved);
+        connect(view->verticalScrollBar(), &QScrollBar::valueChanged, this, &FramebufferRenderer::onCameraMoved);
+        connect(view, &GameView::pixelZoomChanged, this, &FramebufferRenderer::onCameraMoved);
+    }
+}
+
+FramebufferRenderer::~FramebufferRenderer()
+{
+    close();
+}
+
+bool FramebufferRenderer::open(const QString &path)
+{
+    close();
+
+    fd = ::open(path.toLocal8Bit().constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        qDebug() << "Failed to open framebuffer" << path << ":" << strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    isDevice = fstat(fd, &info) == 0 && S_ISCHR(info.st_mode);
+
+    if (!(isDevice ? openDevice() : openFile(path))) {
+        close();
+        return false;
+    }
+
+    if (pageCount < 2) {
+        staging = QImage(width, height, format);
+    }
+
+    qDebug() << "Framebuffer" << path << width << "x" << height
+             << (format == QImage::Format_RGB16 ? "RGB565" : "XRGB8888")
+             << (pageCount > 1 ? "page flipping" : "copying");
+
+    requestFrame();
+    return true;
+}
+
+bool FramebufferRenderer::openDevice()
+{
+    struct fb_var_screeninfo var;
+    struct fb_fix_screeninfo fix;
+    if (ioctl(fd, FBIOGET_VSCREENINFO, &var) < 0 || ioctl(fd, FBIOGET_FSCREENINFO, &fix) < 0) {
+        qDebug() << "Framebuffer ioctl failed:" << strerror(errno);
+        return false;
+    }
+
+    if (var.bits_per_pixel == 16) {
+        format = QImage::Format_RGB16;
+    } else if (var.bits_per_pixel == 32) {
+        format = QImage::Format_RGB32;
+    } else {
+        qDebug() << "Unsupported framebuffer depth:" << var.bits_per_pixel;
+        return false;
+    }
+
+    width = var.xres;
+    height = var.yres;
+    stride = fix.line_length;
+
+    // Ask for a second page so we can flip instead of copy
+    if (var.yres_virtual < var.yres * 2) {
+        struct fb_var_screeninfo wanted = var;
+        wanted.yres_virtual = var.yres * 2;
+        if (ioctl(fd, FBIOPUT_VSCREENINFO, &wanted) == 0) {
+            ioctl(fd, FBIOGET_VSCREENINFO, &var);
+        }
+    }
+    pageCount = var.yres_virtual >= var.yres * 2 ? 2 : 1;
+
+    mappedSize = static_cast<size_t>(stride) * height * pageCount;
+    if (mappedSize > fix.smem_len) {
+        pageCount = 1;
+        mappedSize = static_cast<size_t>(stride) * height;
+    }
+
+    void *addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        qDebug() << "Failed to mmap framebuffer:" << strerror(errno);
+        return false;
+    }
+    mapped = static_cast<uchar *>(addr);
+
+    // Start drawing on the page that isn't being scanned out
+    backPage = (pageCount > 1 && var.yoffset == 0) ? 1 : 0;
+    return true;
+}
+
+bool FramebufferRenderer::openFile(const QString &path)
+{
+    width = kFakeWidth;
+    height = kFakeHeight;
+    format = QImage::Format_RGB32;
+    stride = width * 4;
+    pageCount = 1;
+    backPage = 0;
+    mappedSize = static_cast<size_t>(stride) * height;
+
+    if (ftruncate(fd, static_cast<off_t>(mappedSize)) < 0) {
+        qDebug() << "Failed to size fake framebuffer" << path << ":" << strerror(errno);
+        return false;
+    }
+
+    void *addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        qDebug() << "Failed to mmap fake framebuffer:" << strerror(errno);
+        return false;
+    }
+    mapped = static_cast<uchar *>(addr);
+    return true;
+}
+
+void FramebufferRenderer::close()
+{
+    frameTimer.stop();
+
+    if (mapped) {
+        munmap(mapped, mappedSize);
+        mapped = nullptr;
+        mappedSize = 0;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    staging = QImage();
+}
+
+void FramebufferRenderer::requestFrame()
+{
+    watchScene();
+    fullUpdate = true;
+    scheduleFrame();
+}
+
+void FramebufferRenderer::watchScene()
+{
+    // Battles and the overworld swap scenes on the same view
+    QGraphicsScene *scene = view ? view->scene() : nullptr;
+    if (scene == watchedScene) return;
+
+    if (watchedScene) {
+        disconnect(watchedScene, &QGraphicsScene::changed, this, &FramebufferRenderer::onSceneChanged);
+    }
+    watchedScene = scene;
+    if (scene) {
+        connect(scene, &QGraphicsScene::changed, this, &FramebufferRenderer::onSceneChanged);
+    }
+    fullUpdate = true;
+}
+
+void FramebufferRenderer::scheduleFrame()
+{
+    if (mapped && !frameTimer.isActive()) {
+        frameTimer.start();
+    }
+}
+
+void FramebufferRenderer::onSceneChanged(const QList<QRectF> &region)
+{
+    // An empty list means the whole scene
+    if (region.isEmpty()) {
+        fullUpdate = true;
+    } else {
+        dirtyRects += region;
+    }
+    scheduleFrame();
+}
+
+void FramebufferRenderer::onCameraMoved()
+{
+    fullUpdate = true;
+    scheduleFrame();
+}
+
+void FramebufferRenderer::onFrameTimer()
+{
+    PROFILE_ZONE("fb.frame");
+    if (!mapped || !view) return;
+
+    watchScene();
+    if (!watchedScene) return;
+
+    const QList<QRectF> dirty = dirtyRects;
+    const bool full = fullUpdate;
+    dirtyRects.clear();
+    fullUpdate = false;
+
+    // With two pages the painter writes straight into the mapped back page
+    QImage page;
+    QImage *target = &staging;
+    if (pageCount > 1) {
+        page = QImage(mapped + static_cast<size_t>(backPage) * stride * height,
+                      width, height, stride, format);
+        target = &page;
+    }
+
+    {
+        QPainter painter(target);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+        view->renderFrame(&painter, QRect(0, 0, width, height), dirty, full);
+    }
+    present();
+}
+
+void FramebufferRenderer::present()
+{
+    if (pageCount > 1) {
+        struct fb_var_screeninfo var;
+        if (ioctl(fd, FBIOGET_VSCREENINFO, &var) == 0) {
+            var.yoffset = backPage * height;
+            // Takes effect at the next vertical blank on most drivers
+            if (ioctl(fd, FBIOPAN_DISPLAY, &var) < 0) {
+                qDebug() << "FBIOPAN_DISPLAY failed:" << strerror(errno);
+            }
+        }
+        backPage ^= 1;
+    } else {
+        if (isDevice) {
+            // Not every driver supports this; tearing is the only cost if not
+            quint32 screen = 0;
+            ioctl(fd, FBIO_WAITFORVSYNC, &screen);
+        }
+
+        const int lineBytes = qMin(stride, static_cast<int>(staging.bytesPerLine()));
+        for (int y = 0; y < height; ++y) {
+            memcpy(mapped + static_cast<size_t>(y) * stride, staging.constScanLine(y), lineBytes);
+        }
+    }
+
+    ++presented;
+}
@@ -0,0 +1,76 @@
+#ifndef FRAMEBUFFER_RENDERER_H
+#define FRAMEBUFFER_RENDERER_H
+
+#include <QObject>
+#include <QImage>
+#include <QRectF>
+#include <QTimer>
+#include <QPointer>
+#include <QList>
+#include <QGraphicsScene>
+
+class GameView;
+
+// Optional output straight to a Linux framebuffer. The scene shown by the
+// view is composed into an mmap'd back buffer and presented by panning
+// (page flip) when the driver has room for two pages, or by a vsync-aligned
+// memcpy otherwise. A plain file can stand in for /dev/fb0 when testing on
+// a desktop; it then holds raw 32-bit XRGB frames.
+//
+// Nothing polls: a frame is queued when the scene reports a change, the
+// camera scrolls or zooms, or requestFrame() is called after the view
+// switched scenes. Composition goes through GameView::renderFrame(), so the
+// overworld reuses the view's 1x buffer and only the changed rects are
+// re-rendered before the nearest-neighbour upscale.
+class FramebufferRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FramebufferRenderer(GameView *view, QObject *parent = nullptr);
+    ~FramebufferRenderer();
+
+    // path is a framebuffer device or a regular file (created if missing)
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return mapped != nullptr; }
+
+    // Redraw everything soon. Call after the view switched scenes, since
+    // QGraphicsView has no signal for that.
+    void requestFrame();
+
+    quint64 framesPresented() const { return presented; }
+
+private slots:
+    void onSceneChanged(const QList<QRectF> &region);
+    void onCameraMoved();
+    void onFrameTimer();
+
+private:
+    QPointer<GameView> view;
+    QPointer<QGraphicsScene> watchedScene;
+    QTimer frameTimer;        // Single-shot; coalesces notifications into one frame
+    QList<QRectF> dirtyRects; // Scene rects changed since the last frame
+    bool fullUpdate = true;   // Camera moved or the scene was swapped
+    quint64 presented = 0;
+
+    int fd = -1;
+    bool isDevice = false;
+    uchar *mapped = nullptr;
+    size_t mappedSize = 0;
+    int width = 0;
+    int height = 0;
+    int stride = 0;           // Bytes per line in the framebuffer
+    int pageCount = 1;        // 2 when the virtual screen fits a back page
+    int backPage = 0;
+    QImage::Format format = QImage::Format_Invalid;
+    QImage staging;           // Compose target when we can't page flip
+
+    bool openDevice();
+    bool openFile(const QString &path);
+    void watchScene();
+    void scheduleFrame();
+    void present();
+};
+
+#endif // FRAMEBUFFER_RENDERER_H
@@ -0,0 +1,49 @@
+#include "game_loop.h"
+
+GameLoop::GameLoop(QObject *parent, int ticksPerSecond)
+    : QObject(parent), stepNs(1000000000LL / qMax(1, ticksPerSecond))
+{
+    // Wake a little more often than the step so a late timer never skips a frame
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    frameTimer.setInterval(qMax(1, static_cast<int>(stepNs / 1000000) - 1));
+    connect(&frameTimer, &QTimer::timeout, this, &GameLoop::onFrame);
+}
+
+void GameLoop::start()
+{
+    if (frameTimer.isActive()) return;
+
+    clock.start();
+    lastNs = 0;
+    accumulatorNs = 0;
+    frameTimer.start();
+}
+
+void GameLoop::stop()
+{
+    frameTimer.stop();
+    accumulatorNs = 0;
+}
+
+void GameLoop::onFrame()
+{
+    const qint64 now = clock.nsecsElapsed();
+    accumulatorNs += now - lastNs;
+    lastNs = now;
+
+    int ticks = 0;
+    while (accumulatorNs >= stepNs && ticks < kMaxTicksPerFrame) {
+        emit tick(stepSeconds());
+        accumulatorNs -= stepNs;
+        ++ticks;
+
+        // A tick handler may have stopped us (battle started, screen changed)
+        if (!frameTimer.isActive()) return;
+    }
+
+    if (accumulatorNs >= stepNs) {
+        accumulatorNs %= stepNs;
+    }
+
+    emit render(static_cast<qreal>(accumulatorNs) / stepNs);
+}
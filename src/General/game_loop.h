@@ -0,0 +1,46 @@
+#ifndef GAME_LOOP_H
+#define GAME_LOOP_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+// Fixed-timestep simulation loop. Real elapsed time is accumulated and
+// consumed in whole steps, so movement speed no longer depends on how often
+// the event loop gets around to us. After the steps for a frame, render()
+// carries the leftover fraction of a step for interpolating positions.
+class GameLoop : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GameLoop(QObject *parent = nullptr, int ticksPerSecond = 60);
+
+    void start();
+    void stop();
+    bool isRunning() const { return frameTimer.isActive(); }
+
+    qreal stepSeconds() const { return stepNs / 1e9; }
+
+signals:
+    // One simulation step of stepSeconds()
+    void tick(qreal dt);
+    // Once per frame after the ticks; alpha in [0, 1) is how far we are into the next step
+    void render(qreal alpha);
+
+private slots:
+    void onFrame();
+
+private:
+    QTimer frameTimer;
+    QElapsedTimer clock;
+    qint64 stepNs;
+    qint64 lastNs = 0;
+    qint64 accumulatorNs = 0;
+
+    // After a stall (window hidden, debugger) drop the backlog instead of
+    // running hundreds of catch-up steps in one frame
+    static constexpr int kMaxTicksPerFrame = 5;
+};
+
+#endif // GAME_LOOP_H
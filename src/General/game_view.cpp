@@ -0,0 +1,139 @@
+#include "game_view.h"
+#include "frame_profiler.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+
+GameView::GameView(QGraphicsScene *scene, QWidget *parent)
+    : QGraphicsView(scene, parent)
+{
+}
+
+void GameView::setPixelZoom(int newZoom)
+{
+    newZoom = qMax(1, newZoom);
+    if (newZoom == zoom) return;
+
+    zoom = newZoom;
+    buffer = QImage();
+    viewport()->update();
+    emit pixelZoomChanged(zoom);
+}
+
+bool GameView::ensureBuffer()
+{
+    const QSize bufferSize((viewport()->width() + zoom - 1) / zoom,
+                           (viewport()->height() + zoom - 1) / zoom);
+    if (buffer.size() == bufferSize) return false;
+
+    buffer = QImage(bufferSize, QImage::Format_RGB32);
+    return true;
+}
+
+void GameView::renderBuffer(const QRect &bufferRect)
+{
+    const QRect deviceRect(bufferRect.topLeft() * zoom, bufferRect.size() * zoom);
+    const QRectF source = mapToScene(deviceRect).boundingRect();
+
+    QPainter painter(&buffer);
+    painter.setClipRect(bufferRect);
+    painter.fillRect(bufferRect, backgroundBrush().style() == Qt::NoBrush
+                                     ? QBrush(Qt::black) : backgroundBrush());
+    // The view transform scaled down by the zoom: scene to buffer pixels
+    const QTransform sceneToBuffer = viewportTransform() * QTransform::fromScale(1.0 / zoom, 1.0 / zoom);
+    paintItems(&painter, source, sceneToBuffer, false);
+}
+
+void GameView::paintEvent(QPaintEvent *event)
+{
+    PROFILE_FRAME();
+    PROFILE_ZONE("view.paint");
+
+    if (zoom <= 1 || !scene()) {
+        QGraphicsView::paintEvent(event);
+        return;
+    }
+
+    // A fresh buffer is filled completely, since renderFrame() blits all of it
+    const bool fresh = ensureBuffer();
+
+    // Dirty area in buffer pixels, widened to whole zoom blocks
+    const QRect dirty = event->rect();
+    const QRect bufferRect = QRect(QPoint(dirty.left() / zoom, dirty.top() / zoom),
+                                   QPoint(dirty.right() / zoom, dirty.bottom() / zoom))
+                             & buffer.rect();
+    if (bufferRect.isEmpty()) return;
+
+    renderBuffer(fresh ? buffer.rect() : bufferRect);
+
+    const QRect deviceRect(bufferRect.topLeft() * zoom, bufferRect.size() * zoom);
+    const QRectF source = mapToScene(deviceRect).boundingRect();
+
+    // Without SmoothPixmapTransform this is a nearest-neighbour upscale
+    QPainter painter(viewport());
+    painter.setClipRect(deviceRect);
+    painter.drawImage(deviceRect, buffer, bufferRect);
+    paintItems(&painter, source, viewportTransform(), true);
+}
+
+void GameView::renderFrame(QPainter *painter, const QRect &target, const QList<QRectF> &dirtyScene,
+                           bool fullUpdate)
+{
+    PROFILE_ZONE("view.renderFrame");
+    if (!scene()) return;
+
+    const QRect viewRect = viewport()->rect();
+    if (zoom <= 1) {
+        // Nothing is pixel-doubled; at the native size this is a straight copy
+        painter->fillRect(target, backgroundBrush().style() == Qt::NoBrush
+                                      ? QBrush(Qt::black) : backgroundBrush());
+        render(painter, target, viewRect, Qt::IgnoreAspectRatio);
+        return;
+    }
+
+    // Only what changed since the last frame is re-rendered; the rest of the
+    // 1x buffer is still current
+    const QTransform sceneToBuffer = viewportTransform() * QTransform::fromScale(1.0 / zoom, 1.0 / zoom);
+    if (ensureBuffer() || fullUpdate) {
+        renderBuffer(buffer.rect());
+    } else {
+        for (const QRectF &rect : dirtyScene) {
+            const QRect bufferRect = sceneToBuffer.mapRect(rect).toAlignedRect() & buffer.rect();
+            if (!bufferRect.isEmpty()) renderBuffer(bufferRect);
+        }
+    }
+
+    // Viewport pixels to target pixels; without SmoothPixmapTransform the
+    // blit is a nearest-neighbour upscale
+    const QTransform viewToTarget = QTransform::fromScale(qreal(target.width()) / viewRect.width(),
+                                                          qreal(target.height()) / viewRect.height())
+                                    * QTransform::fromTranslate(target.left(), target.top());
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter->drawImage(target, buffer, QRectF(0, 0, qreal(viewRect.width()) / zoom,
+                                              qreal(viewRect.height()) / zoom));
+    paintItems(painter, mapToScene(viewRect).boundingRect(), viewportTransform() * viewToTarget, true);
+    painter->restore();
+}
+
+void GameView::paintItems(QPainter *painter, const QRectF &sceneRect, const QTransform &sceneToDevice,
+                          bool overlay)
+{
+    // Bottom to top, as QGraphicsScene::render would. The overworld scene
+    // uses no clipping or effects, so the items can be painted directly.
+    const QList<QGraphicsItem *> items = scene()->items(sceneRect, Qt::IntersectsItemBoundingRect,
+                                                        Qt::AscendingOrder);
+    QStyleOptionGraphicsItem option;
+    for (QGraphicsItem *item : items) {
+        if (!item->isVisible() || (item->flags() & QGraphicsItem::ItemHasNoContents)) continue;
+        if (isOverlay(item->topLevelItem()) != overlay) continue;
+
+        painter->save();
+        painter->setTransform(item->sceneTransform() * sceneToDevice);
+        painter->setOpacity(item->effectiveOpacity());
+        option.exposedRect = item->boundingRect();
+        item->paint(painter, &option, viewport());
+        painter->restore();
+    }
+}
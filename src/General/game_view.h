@@ -0,0 +1,58 @@
+#ifndef GAME_VIEW_H
+#define GAME_VIEW_H
+
+#include <QGraphicsView>
+#include <QImage>
+#include <QGraphicsItem>
+
+// QGraphicsView that paints pixel-art zoom cheaply. The view keeps its
+// scaling transform for geometry (centerOn, mapToScene), but paintEvent
+// renders the scene at 1x into a small offscreen buffer (240x136 for the
+// 2x overworld) and blits the dirty part of it upscaled with nearest-neighbour
+// sampling, instead of Qt scaling every item's pixmap as it paints. Items
+// marked with markOverlay() (menus and their text) are left out of the 1x
+// pass and painted afterwards at screen resolution, so text is not
+// pixel-doubled.
+class GameView : public QGraphicsView
+{
+    Q_OBJECT
+
+public:
+    explicit GameView(QGraphicsScene *scene, QWidget *parent = nullptr);
+
+    // Tag a top-level item (children follow their parent) to be painted
+    // over the upscaled buffer instead of into it
+    static void markOverlay(QGraphicsItem *item) { item->setData(kOverlayKey, true); }
+    static bool isOverlay(const QGraphicsItem *item) { return item->data(kOverlayKey).toBool(); }
+
+    // Whole-number zoom matching the view transform; 1 paints normally
+    void setPixelZoom(int zoom);
+    int pixelZoom() const { return zoom; }
+
+    // Compose the whole view into target the way paintEvent does, for
+    // outputs other than the widget (the framebuffer). Only dirtyScene is
+    // re-rendered into the 1x buffer, or all of it when fullUpdate is set;
+    // the buffer is then upscaled nearest-neighbour to target.
+    void renderFrame(QPainter *painter, const QRect &target, const QList<QRectF> &dirtyScene,
+                     bool fullUpdate);
+
+signals:
+    void pixelZoomChanged(int zoom);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    static constexpr int kOverlayKey = 0x4f56;  // QGraphicsItem::data() key
+
+    int zoom = 1;
+    QImage buffer;  // Scene at 1x, one pixel per zoom x zoom block on screen
+
+    // Reallocate the buffer for the viewport size; true if it was
+    bool ensureBuffer();
+    void renderBuffer(const QRect &bufferRect);
+    void paintItems(QPainter *painter, const QRectF &sceneRect, const QTransform &sceneToDevice,
+                    bool overlay);
+};
+
+#endif // GAME_VIEW_H
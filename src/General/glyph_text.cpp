@@ -0,0 +1,306 @@
+#include "glyph_text.h"
+#include <QFontMetrics>
+#include <QImage>
+#include <QHash>
+#include <QCoreApplication>
+#include <QSharedPointer>
+#include <QPaintEvent>
+#include <QDebug>
+
+// ================================================
+// GlyphAtlas
+// ================================================
+
+QSharedPointer<const GlyphAtlas> GlyphAtlas::get(const QFont &font, const QColor &color)
+{
+    static QHash<QString, QSharedPointer<GlyphAtlas>> atlases;
+    static bool releaseOnQuit = false;
+    if (!releaseOnQuit && QCoreApplication::instance()) {
+        // The hash outlives QApplication, but the pixmaps in it must not
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                         []() { atlases.clear(); });
+        releaseOnQuit = true;
+    }
+
+    const QString key = font.key() + "|" + color.name(QColor::HexArgb);
+    auto it = atlases.find(key);
+    if (it == atlases.end()) {
+        it = atlases.insert(key, QSharedPointer<GlyphAtlas>::create(font, color));
+    }
+    return *it;
+}
+
+int GlyphAtlas::index(QChar c)
+{
+    const int code = c.unicode();
+    if (code < kFirst || code > kLast) {
+        return '?' - kFirst;
+    }
+    return code - kFirst;
+}
+
+GlyphAtlas::GlyphAtlas(const QFont &font, const QColor &color)
+{
+    const QFontMetrics fm(font);
+    const int cellH = fm.height();
+    spacing = fm.lineSpacing();
+
+    // Cells are a glyph's advance or ink width, whichever is wider, so
+    // overhanging bold glyphs aren't clipped. Rows wrap at 512 px.
+    constexpr int kRowWidth = 512;
+    int x = 0;
+    int y = 0;
+    int cellW[kCount];
+    QPoint cellPos[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        const QChar c(kFirst + i);
+        advances[i] = fm.horizontalAdvance(c);
+        cellW[i] = qMax(advances[i], fm.boundingRect(c).right() + 1) + 1;
+        if (x + cellW[i] > kRowWidth) {
+            x = 0;
+            y += cellH;
+        }
+        cellPos[i] = QPoint(x, y);
+        rects[i] = QRectF(x, y, cellW[i], cellH);
+        x += cellW[i];
+    }
+
+    QImage image(kRowWidth, y + cellH, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setFont(font);
+        painter.setPen(color);
+        for (int i = 0; i < kCount; ++i) {
+            painter.drawText(cellPos[i].x(), cellPos[i].y() + fm.ascent(), QString(QChar(kFirst + i)));
+        }
+    }
+    page = QPixmap::fromImage(image);
+
+    qDebug() << "Glyph atlas for" << font.family() << font.pointSize() << "pt:"
+             << page.width() << "x" << page.height();
+}
+
+// ================================================
+// GlyphText
+// ================================================
+
+void GlyphText::setFont(const QFont &font, const QColor &color)
+{
+    atlas = GlyphAtlas::get(font, color);
+    relayout();
+}
+
+void GlyphText::setWidth(int w)
+{
+    if (width == w) return;
+    width = w;
+    relayout();
+}
+
+void GlyphText::setWordWrap(bool on)
+{
+    if (wrap == on) return;
+    wrap = on;
+    relayout();
+}
+
+void GlyphText::setAlignment(Qt::Alignment alignment)
+{
+    align = alignment & Qt::AlignHorizontal_Mask;
+    relayout();
+}
+
+void GlyphText::setText(const QString &text)
+{
+    fullText = text;
+    relayout();
+}
+
+void GlyphText::relayout()
+{
+    fragments.clear();
+    fragmentsBefore.fill(0, fullText.size() + 1);
+    extent = QSizeF();
+    if (!atlas) return;
+
+    // Split into lines as [start, end) ranges. Wrapping breaks at the last
+    // space that fits; the space itself isn't drawn.
+    QVector<QPair<int, int>> lines;
+    int lineStart = 0;
+    int lastSpace = -1;
+    int x = 0;
+    for (int i = 0; i < fullText.size(); ++i) {
+        const QChar c = fullText[i];
+        if (c == '\n') {
+            lines.append({lineStart, i});
+            lineStart = i + 1;
+            lastSpace = -1;
+            x = 0;
+            continue;
+        }
+
+        const int w = atlas->advance(c);
+        if (wrap && width > 0 && x + w > width && c != ' ' && lastSpace > lineStart) {
+            lines.append({lineStart, lastSpace});
+            lineStart = lastSpace + 1;
+            lastSpace = -1;
+            x = 0;
+            for (int j = lineStart; j < i; ++j) {
+                x += atlas->advance(fullText[j]);
+            }
+        }
+        if (c == ' ') {
+            lastSpace = i;
+        }
+        x += w;
+    }
+    lines.append({lineStart, fullText.size()});
+
+    const int lineHeight = atlas->lineSpacing();
+    qreal maxWidth = 0;
+    int next = 0;  // Next character whose fragment count isn't set yet
+    for (int l = 0; l < lines.size(); ++l) {
+        const int start = lines[l].first;
+        const int end = lines[l].second;
+
+        int lineWidth = 0;
+        for (int i = start; i < end; ++i) {
+            lineWidth += atlas->advance(fullText[i]);
+        }
+        maxWidth = qMax<qreal>(maxWidth, lineWidth);
+
+        qreal penX = 0;
+        if ((align & Qt::AlignHCenter) && width > 0) {
+            penX = (width - lineWidth) / 2.0;
+        }
+        const qreal penY = l * lineHeight;
+
+        for (; next < start; ++next) {
+            fragmentsBefore[next + 1] = fragments.size();
+        }
+        for (int i = start; i < end; ++i) {
+            const QChar c = fullText[i];
+            if (c != ' ') {
+                const QRectF src = atlas->source(c);
+                // Fragments are positioned by their centre
+                fragments.append(QPainter::PixmapFragment::create(
+                    QPointF(penX + src.width() / 2, penY + src.height() / 2), src));
+            }
+            penX += atlas->advance(c);
+            fragmentsBefore[i + 1] = fragments.size();
+        }
+        next = end;
+    }
+    for (; next < fullText.size(); ++next) {
+        fragmentsBefore[next + 1] = fragments.size();
+    }
+
+    extent = QSizeF(width > 0 ? width : maxWidth, lines.size() * lineHeight);
+}
+
+void GlyphText::draw(QPainter *painter, const QPointF &origin) const
+{
+    if (!atlas) return;
+
+    const int count = fragmentsBefore[qBound(0, visibleCount(), fullText.size())];
+    if (count == 0) return;
+
+    painter->save();
+    painter->translate(origin);
+    painter->drawPixmapFragments(fragments.constData(), count, atlas->pixmap());
+    painter->restore();
+}
+
+// ================================================
+// GlyphTextItem
+// ================================================
+
+GlyphTextItem::GlyphTextItem(const QFont &font, const QColor &color, QGraphicsItem *parent)
+    : QGraphicsItem(parent)
+{
+    glyphs.setFont(font, color);
+}
+
+void GlyphTextItem::setText(const QString &text)
+{
+    prepareGeometryChange();
+    glyphs.setText(text);
+    glyphs.setVisibleCount(-1);
+}
+
+void GlyphTextItem::setVisibleCount(int count)
+{
+    if (glyphs.visibleCount() == count) return;
+    glyphs.setVisibleCount(count);
+    update();
+}
+
+QRectF GlyphTextItem::boundingRect() const
+{
+    return QRectF(QPointF(0, 0), glyphs.size());
+}
+
+void GlyphTextItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+    glyphs.draw(painter);
+}
+
+// ================================================
+// GlyphLabel
+// ================================================
+
+GlyphLabel::GlyphLabel(const QFont &font, const QColor &color, QWidget *parent)
+    : QWidget(parent)
+{
+    glyphs.setFont(font, color);
+}
+
+void GlyphLabel::setText(const QString &text)
+{
+    glyphs.setWidth(width());
+    glyphs.setText(text);
+    glyphs.setVisibleCount(-1);
+    update();
+}
+
+void GlyphLabel::setVisibleCount(int count)
+{
+    if (glyphs.visibleCount() == count) return;
+    glyphs.setVisibleCount(count);
+    update();
+}
+
+void GlyphLabel::setWordWrap(bool on)
+{
+    glyphs.setWordWrap(on);
+    update();
+}
+
+void GlyphLabel::setAlignment(Qt::Alignment alignment)
+{
+    align = alignment;
+    glyphs.setAlignment(alignment);
+    update();
+}
+
+void GlyphLabel::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    glyphs.setWidth(width());
+}
+
+void GlyphLabel::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    qreal top = 0;
+    if (align & Qt::AlignVCenter) {
+        top = (height() - glyphs.size().height()) / 2.0;
+    }
+
+    QPainter painter(this);
+    glyphs.draw(&painter, QPointF(0, top));
+}
@@ -0,0 +1,124 @@
+#ifndef GLYPH_TEXT_H
+#define GLYPH_TEXT_H
+
+#include <QWidget>
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QPixmap>
+#include <QSharedPointer>
+#include <QFont>
+#include <QColor>
+#include <QString>
+#include <QVector>
+
+// One font in one colour, pre-rendered: every Latin-1 character is drawn
+// once into a single pixmap. Atlases are shared, so each font/colour pair
+// is rasterised once per run. GUI thread only.
+class GlyphAtlas
+{
+public:
+    // Shared per font and colour. The cache is emptied when the application
+    // is about to quit; GlyphText keeps its own reference until it goes.
+    static QSharedPointer<const GlyphAtlas> get(const QFont &font, const QColor &color);
+
+    const QPixmap& pixmap() const { return page; }
+    QRectF source(QChar c) const { return rects[index(c)]; }
+    int advance(QChar c) const { return advances[index(c)]; }
+    int lineSpacing() const { return spacing; }
+
+    GlyphAtlas(const QFont &font, const QColor &color);
+
+private:
+    static constexpr int kFirst = 32;    // Space
+    static constexpr int kLast = 255;    // End of Latin-1
+    static constexpr int kCount = kLast - kFirst + 1;
+
+    static int index(QChar c);
+
+    QPixmap page;
+    QRectF rects[kCount];
+    int advances[kCount];
+    int spacing = 0;
+};
+
+// Laid-out text drawn from a GlyphAtlas. setText() works out where every
+// glyph goes once; after that, drawing is a single drawPixmapFragments()
+// call. A typewriter reveal only changes the visible count, so there is no
+// relayout or allocation per character.
+class GlyphText
+{
+public:
+    void setFont(const QFont &font, const QColor &color);
+
+    // Width of the box, used to wrap (if wordWrap) and to centre lines.
+    // 0 means lines only break at '\n'.
+    void setWidth(int width);
+    void setWordWrap(bool on);
+    void setAlignment(Qt::Alignment alignment);  // Left or HCenter
+
+    void setText(const QString &text);
+    const QString& text() const { return fullText; }
+
+    // How many characters of text() to draw; -1 (the default) draws them all
+    void setVisibleCount(int count) { visible = count; }
+    int visibleCount() const { return visible < 0 ? fullText.size() : visible; }
+
+    QSizeF size() const { return extent; }
+    void draw(QPainter *painter, const QPointF &origin = QPointF()) const;
+
+private:
+    QSharedPointer<const GlyphAtlas> atlas;
+    QString fullText;
+    int width = 0;
+    bool wrap = false;
+    Qt::Alignment align = Qt::AlignLeft;
+    int visible = -1;
+
+    QVector<QPainter::PixmapFragment> fragments;
+    QVector<int> fragmentsBefore;  // Per character: glyphs drawn before it
+    QSizeF extent;
+
+    void relayout();
+};
+
+// GlyphText as a scene item, for the battle dialogue
+class GlyphTextItem : public QGraphicsItem
+{
+public:
+    GlyphTextItem(const QFont &font, const QColor &color, QGraphicsItem *parent = nullptr);
+
+    void setText(const QString &text);
+    const QString& text() const { return glyphs.text(); }
+    void setVisibleCount(int count);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    GlyphText glyphs;
+};
+
+// GlyphText as a widget, standing in for a QLabel on the intro and lab screens
+class GlyphLabel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    GlyphLabel(const QFont &font, const QColor &color, QWidget *parent = nullptr);
+
+    void setText(const QString &text);
+    const QString& text() const { return glyphs.text(); }
+    void setVisibleCount(int count);
+    void setWordWrap(bool on);
+    void setAlignment(Qt::Alignment alignment);  // Left or HCenter, plus Top or VCenter
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    GlyphText glyphs;
+    Qt::Alignment align = Qt::AlignLeft | Qt::AlignTop;
+};
+
+#endif // GLYPH_TEXT_H
@@ -0,0 +1,251 @@
+#include "link_io_thread.h"
+#include "link_transport.h"
+#include "frame_profiler.h"
+#include <QDebug>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+
+LinkIoThread::LinkIoThread(LinkTransport *transport, QObject *parent)
+    : QThread(parent), transport(transport), running(true), wakeFd(-1),
+      bytesRead(0), bytesWritten(0), eventHighWater(0), notifyPending(false)
+{
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        qDebug() << "Failed to create link wake eventfd:" << strerror(errno);
+    }
+}
+
+LinkIoThread::~LinkIoThread()
+{
+    stop();
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+        wakeFd = -1;
+    }
+}
+
+void LinkIoThread::stop()
+{
+    running = false;
+    wake();
+    wait();
+}
+
+bool LinkIoThread::post(LinkCommand command)
+{
+    if (!commands.push(std::move(command))) {
+        qDebug() << "Link command queue full, dropping command";
+        return false;
+    }
+    wake();
+    return true;
+}
+
+void LinkIoThread::resetCounters()
+{
+    bytesRead = 0;
+    bytesWritten = 0;
+    eventHighWater = static_cast<int>(events.size());
+}
+
+void LinkIoThread::wake()
+{
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+        Q_UNUSED(ignored);
+    }
+}
+
+void LinkIoThread::run()
+{
+    // running starts true so a stop() issued before the thread is scheduled still sticks
+    while (running) {
+        processCommands();
+
+        // Stop reading while the GUI is behind; the kernel buffers the rest
+        const bool canRead = !events.isFull();
+        const int linkFd = transport->fd();
+
+        struct pollfd fds[2];
+        fds[0].fd = wakeFd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = linkFd;
+        fds[1].events = canRead ? POLLIN : 0;
+        fds[1].revents = 0;
+
+        int ready = poll(fds, linkFd >= 0 ? 2 : 1, canRead ? 100 : 5);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            qDebug() << "Link poll failed:" << strerror(errno);
+            pushEvent(LinkEvent{LinkEvent::Kind::Failed, BattlePacket(), QString(), true});
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            uint64_t count;
+            ssize_t ignored = ::read(wakeFd, &count, sizeof(count));
+            Q_UNUSED(ignored);
+        }
+
+        if (linkFd >= 0 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+            // Listening socket: a peer is knocking
+            if (!transport->isConnected()) {
+                if (transport->acceptPending()) {
+                    pushEvent(LinkEvent{LinkEvent::Kind::Connected, BattlePacket(), QString(), true});
+                }
+                continue;
+            }
+
+            if (!readAvailable()) {
+                break;
+            }
+        }
+    }
+
+    running = false;
+}
+
+void LinkIoThread::processCommands()
+{
+    LinkCommand command;
+    while (commands.pop(command)) {
+        switch (command.kind) {
+            case LinkCommand::Kind::Write:
+                if (transport->isConnected()) {
+                    writeAll(command.bytes);
+                }
+                break;
+
+            case LinkCommand::Kind::SetBaudRate:
+                if (!transport->setBaudRate(command.baudRate)) {
+                    qDebug() << "Link thread failed to switch to" << command.baudRate << "baud";
+                }
+                // Anything still buffered was framed at the old rate
+                transport->flushInput();
+                receiveBuffer.clear();
+                break;
+        }
+    }
+}
+
+void LinkIoThread::writeAll(const QByteArray& bytes)
+{
+    PROFILE_ZONE("link.write");
+    const char *data = bytes.constData();
+    size_t remaining = static_cast<size_t>(bytes.size());
+
+    while (remaining > 0) {
+        ssize_t written = transport->write(data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // Output buffer full (socket or pty); wait briefly for room
+                struct pollfd pfd;
+                pfd.fd = transport->fd();
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                if (poll(&pfd, 1, 50) <= 0) {
+                    qDebug() << "Link write stalled, dropping" << remaining << "bytes";
+                    return;
+                }
+                continue;
+            }
+            qDebug() << "Error writing to link:" << strerror(errno);
+            return;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+        bytesWritten.fetch_add(static_cast<quint64>(written), std::memory_order_relaxed);
+    }
+
+    // Ensure data is written
+    transport->drain();
+}
+
+bool LinkIoThread::readAvailable()
+{
+    PROFILE_ZONE("link.read");
+    char buffer[512];
+    ssize_t count = transport->read(buffer, sizeof(buffer));
+
+    if (count > 0) {
+        bytesRead.fetch_add(static_cast<quint64>(count), std::memory_order_relaxed);
+        receiveBuffer.append(buffer, static_cast<int>(count));
+        parseLines();
+        return true;
+    }
+
+    if (count < 0) {
+        if (errno == EINTR) return true;
+        qDebug() << "Error reading from link:" << strerror(errno);
+        receiveBuffer.clear();
+        if (transport->isOpen() && !transport->isConnected()) {
+            // Socket listener survives its peer; wait for the next one
+            pushEvent(LinkEvent{LinkEvent::Kind::Disconnected, BattlePacket(), QString(), true});
+            return true;
+        }
+        // A UART or pty that fails a read (EIO once the far end is gone)
+        // stays readable, so polling it again would spin; give it up instead
+        transport->close();
+        pushEvent(LinkEvent{LinkEvent::Kind::Failed, BattlePacket(), QString(), true});
+        return false;
+    }
+
+    return true;
+}
+
+void LinkIoThread::parseLines()
+{
+    int start = 0;
+    int newlineIndex;
+    while ((newlineIndex = receiveBuffer.indexOf('\n', start)) >= 0) {
+        QString line = QString::fromUtf8(receiveBuffer.constData() + start, newlineIndex - start);
+        start = newlineIndex + 1;
+
+        if (line.trimmed().isEmpty()) continue;
+
+        LinkEvent event;
+        event.packet = BattlePacket::deserialize(line, &event.crcOk);
+        event.kind = event.packet.type == PacketType::INVALID ? LinkEvent::Kind::BadPacket
+                                                              : LinkEvent::Kind::Packet;
+        event.raw = line;
+        pushEvent(std::move(event));
+    }
+
+    if (start > 0) {
+        receiveBuffer.remove(0, start);
+    }
+
+    // A peer spewing garbage without newlines shouldn't grow this forever
+    if (receiveBuffer.size() > 4096) {
+        qDebug() << "Discarding" << receiveBuffer.size() << "bytes of unterminated link data";
+        receiveBuffer.clear();
+        pushEvent(LinkEvent{LinkEvent::Kind::BadPacket, BattlePacket(), QString(), true});
+    }
+}
+
+void LinkIoThread::pushEvent(LinkEvent event)
+{
+    // The GUI drains as soon as it is signalled, so a full ring only lasts a
+    // few milliseconds
+    while (!events.push(event)) {
+        if (!running) return;
+        QThread::msleep(1);
+    }
+
+    // One queued signal per batch; the GUI clears the flag before draining
+    if (!notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        emit eventsReady();
+    }
+
+    int depth = static_cast<int>(events.size());
+    if (depth > eventHighWater.load(std::memory_order_relaxed)) {
+        eventHighWater.store(depth, std::memory_order_relaxed);
+    }
+}
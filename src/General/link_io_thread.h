@@ -0,0 +1,100 @@
+#ifndef LINK_IO_THREAD_H
+#define LINK_IO_THREAD_H
+
+#include <QThread>
+#include <QByteArray>
+#include <atomic>
+#include "uart_comm.h"
+#include "spsc_queue.h"
+
+class LinkTransport;
+
+// GUI -> I/O thread
+struct LinkCommand {
+    enum class Kind {
+        Write,        // Send bytes and wait for them to drain
+        SetBaudRate   // Reprogram the line rate and drop stale input
+    };
+
+    Kind kind = Kind::Write;
+    QByteArray bytes;
+    qint32 baudRate = 0;
+};
+
+// I/O thread -> GUI
+struct LinkEvent {
+    enum class Kind {
+        Packet,         // A complete packet with a valid (or absent) CRC
+        BadPacket,      // CRC mismatch or unknown packet type
+        Connected,      // Socket peer accepted
+        Disconnected,   // Peer went away; a listener keeps waiting
+        Failed          // Link is unusable, the thread has stopped
+    };
+
+    Kind kind = Kind::Packet;
+    BattlePacket packet;
+    QString raw;  // Line as received, for logging bad packets
+    bool crcOk = true;
+};
+
+// Owns all reads and writes on a LinkTransport so link traffic never runs on
+// the GUI thread. The GUI posts commands and drains events when eventsReady()
+// fires; both directions go through lock-free single-producer/single-consumer
+// rings.
+class LinkIoThread : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit LinkIoThread(LinkTransport *transport, QObject *parent = nullptr);
+    ~LinkIoThread();
+
+    void stop();
+
+    // GUI thread only. Returns false if the command ring is full.
+    bool post(LinkCommand command);
+
+    // GUI thread only. Returns false once the event ring is empty.
+    bool nextEvent(LinkEvent &event) { return events.pop(event); }
+
+    // GUI thread only. Call before draining so the next push signals again.
+    void acknowledgeEvents() { notifyPending.store(false, std::memory_order_release); }
+
+    // Counters for LinkStats; safe to read from any thread
+    quint64 getBytesRead() const { return bytesRead.load(std::memory_order_relaxed); }
+    quint64 getBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+    int commandQueueDepth() const { return static_cast<int>(commands.size()); }
+    int eventQueueDepth() const { return static_cast<int>(events.size()); }
+    int eventQueueHighWater() const { return eventHighWater.load(std::memory_order_relaxed); }
+    void resetCounters();
+
+signals:
+    // Emitted from the I/O thread when the event ring goes from drained to
+    // non-empty. Pushes before acknowledgeEvents() don't signal again.
+    void eventsReady();
+
+protected:
+    void run() override;
+
+private:
+    LinkTransport *transport;  // Not owned; only touched by this thread while running
+    std::atomic<bool> running;
+    int wakeFd;  // eventfd used to interrupt poll() when commands arrive
+    QByteArray receiveBuffer;
+    std::atomic<quint64> bytesRead;
+    std::atomic<quint64> bytesWritten;
+    std::atomic<int> eventHighWater;
+    std::atomic<bool> notifyPending;
+
+    SpscQueue<LinkCommand, 256> commands;
+    SpscQueue<LinkEvent, 256> events;
+
+    void wake();
+    void processCommands();
+    void writeAll(const QByteArray& bytes);
+    bool readAvailable();
+    void parseLines();
+    void pushEvent(LinkEvent event);
+};
+
+#endif // LINK_IO_THREAD_H
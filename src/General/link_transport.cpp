@@ -0,0 +1,509 @@
+#include "link_transport.h"
+#include <QDebug>
+#include <QByteArray>
+#include <QStringList>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <errno.h>
+#include <string.h>
+#include <pty.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+
+// Map an integer baud rate to its termios constant
+static bool baudToSpeed(qint32 baudRate, speed_t *speed)
+{
+    switch (baudRate) {
+        case 9600: *speed = B9600; return true;
+        case 19200: *speed = B19200; return true;
+        case 38400: *speed = B38400; return true;
+        case 57600: *speed = B57600; return true;
+        case 115200: *speed = B115200; return true;
+        case 230400: *speed = B230400; return true;
+#ifdef B460800
+        case 460800: *speed = B460800; return true;
+#endif
+#ifdef B921600
+        case 921600: *speed = B921600; return true;
+#endif
+#ifdef B1500000
+        case 1500000: *speed = B1500000; return true;
+#endif
+#ifdef B3000000
+        case 3000000: *speed = B3000000; return true;
+#endif
+        default: return false;
+    }
+}
+
+static void setNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags >= 0) {
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+}
+
+// connect() that gives up after timeoutMs instead of the OS's (minutes, for
+// an unreachable host). Leaves fd non-blocking either way.
+static bool connectWithTimeout(int fd, const struct sockaddr *addr, socklen_t len, int timeoutMs)
+{
+    setNonBlocking(fd);
+    if (::connect(fd, addr, len) == 0) return true;
+    if (errno != EINPROGRESS && errno != EAGAIN) return false;
+
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    int ready;
+    do {
+        ready = poll(&pfd, 1, timeoutMs);
+    } while (ready < 0 && errno == EINTR);
+    if (ready <= 0) return false;
+
+    int error = 0;
+    socklen_t errorLen = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &errorLen) != 0) return false;
+    return error == 0;
+}
+
+LinkTransport *LinkTransport::create(const QString& spec, qint32 baudRate)
+{
+    if (spec == "pty") {
+        return new PtyTransport();
+    }
+
+    if (spec.startsWith("unix:")) {
+        return new SocketTransport(SocketTransport::Family::Unix, spec.mid(5));
+    }
+
+    if (spec.startsWith("tcp:")) {
+        // tcp:host:port, or tcp:port for localhost
+        QStringList parts = spec.mid(4).split(':');
+        QString host = parts.size() >= 2 ? parts[0] : QString("127.0.0.1");
+        bool ok = false;
+        quint16 port = parts.last().toUShort(&ok);
+        if (!ok || port == 0) {
+            qDebug() << "Invalid TCP link spec:" << spec;
+            return nullptr;
+        }
+        return new SocketTransport(SocketTransport::Family::Tcp, host, port);
+    }
+
+    return new UartTransport(spec, baudRate);
+}
+
+// ---------------------------------------------------------------------------
+// UartTransport
+// ---------------------------------------------------------------------------
+
+UartTransport::UartTransport(const QString& portName, qint32 baudRate)
+    : portName(portName), baudRate(baudRate)
+{
+}
+
+UartTransport::~UartTransport()
+{
+    close();
+}
+
+bool UartTransport::open()
+{
+    close();
+
+    // Open UART device
+    QByteArray portBytes = portName.toLocal8Bit();
+    uartFd = ::open(portBytes.constData(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if (uartFd < 0) {
+        qDebug() << "Failed to open UART port:" << portName << "Error:" << strerror(errno);
+        return false;
+    }
+
+    // Configure serial port using termios
+    struct termios tty;
+    if (tcgetattr(uartFd, &tty) != 0) {
+        qDebug() << "Failed to get UART attributes:" << strerror(errno);
+        close();
+        return false;
+    }
+
+    // Set baud rate (unsupported rates fall back to 115200)
+    speed_t speed;
+    if (!baudToSpeed(baudRate, &speed)) {
+        baudRate = 115200;
+        speed = B115200;
+    }
+
+    cfsetospeed(&tty, speed);
+    cfsetispeed(&tty, speed);
+
+    // 8N1 configuration
+    tty.c_cflag &= ~PARENB;  // No parity
+    tty.c_cflag &= ~CSTOPB;  // 1 stop bit
+    tty.c_cflag &= ~CSIZE;   // Clear size bits
+    tty.c_cflag |= CS8;      // 8 data bits
+    tty.c_cflag &= ~CRTSCTS; // No hardware flow control
+    tty.c_cflag |= CREAD | CLOCAL; // Enable receiver, ignore modem control lines
+
+    // Disable canonical mode (raw input)
+    tty.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
+
+    // Disable software flow control
+    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
+
+    // Raw output
+    tty.c_oflag &= ~OPOST;
+
+    // Set read timeout (0.1 seconds)
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 1;
+
+    // Apply settings
+    if (tcsetattr(uartFd, TCSANOW, &tty) != 0) {
+        qDebug() << "Failed to set UART attributes:" << strerror(errno);
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void UartTransport::close()
+{
+    if (uartFd >= 0) {
+        ::close(uartFd);
+        uartFd = -1;
+    }
+}
+
+ssize_t UartTransport::read(char *buffer, size_t size)
+{
+    ssize_t n = ::read(uartFd, buffer, size);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+    return n;
+}
+
+ssize_t UartTransport::write(const char *data, size_t size)
+{
+    return ::write(uartFd, data, size);
+}
+
+void UartTransport::drain()
+{
+    if (uartFd >= 0) {
+        tcdrain(uartFd);
+    }
+}
+
+bool UartTransport::supportsBaudRate(qint32 rate) const
+{
+    speed_t speed;
+    return baudToSpeed(rate, &speed);
+}
+
+bool UartTransport::setBaudRate(qint32 rate)
+{
+    if (uartFd < 0) return false;
+
+    speed_t speed;
+    if (!baudToSpeed(rate, &speed)) {
+        qDebug() << "Baud rate not supported by this kernel:" << rate;
+        return false;
+    }
+
+    struct termios tty;
+    if (tcgetattr(uartFd, &tty) != 0) {
+        qDebug() << "Failed to get UART attributes:" << strerror(errno);
+        return false;
+    }
+    cfsetospeed(&tty, speed);
+    cfsetispeed(&tty, speed);
+    if (tcsetattr(uartFd, TCSANOW, &tty) != 0) {
+        qDebug() << "Failed to set UART baud rate" << rate << ":" << strerror(errno);
+        return false;
+    }
+
+    baudRate = rate;
+    return true;
+}
+
+void UartTransport::flushInput()
+{
+    if (uartFd >= 0) {
+        tcflush(uartFd, TCIFLUSH);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// PtyTransport
+// ---------------------------------------------------------------------------
+
+PtyTransport::~PtyTransport()
+{
+    close();
+}
+
+bool PtyTransport::open()
+{
+    close();
+
+    char name[64] = {0};
+    if (openpty(&masterFd, &slaveFd, name, nullptr, nullptr) != 0) {
+        qDebug() << "Failed to open pseudo-terminal:" << strerror(errno);
+        masterFd = -1;
+        slaveFd = -1;
+        return false;
+    }
+    slaveName = QString::fromLocal8Bit(name);
+
+    // Raw mode on the slave so the line discipline doesn't echo or cook packets
+    struct termios tty;
+    if (tcgetattr(slaveFd, &tty) == 0) {
+        cfmakeraw(&tty);
+        tcsetattr(slaveFd, TCSANOW, &tty);
+    }
+    setNonBlocking(masterFd);
+
+    qDebug() << "PTY link ready, point the other instance at" << slaveName;
+    return true;
+}
+
+void PtyTransport::close()
+{
+    if (masterFd >= 0) {
+        ::close(masterFd);
+        masterFd = -1;
+    }
+    if (slaveFd >= 0) {
+        ::close(slaveFd);
+        slaveFd = -1;
+    }
+}
+
+ssize_t PtyTransport::read(char *buffer, size_t size)
+{
+    ssize_t n = ::read(masterFd, buffer, size);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+    return n;
+}
+
+ssize_t PtyTransport::write(const char *data, size_t size)
+{
+    return ::write(masterFd, data, size);
+}
+
+void PtyTransport::flushInput()
+{
+    if (masterFd >= 0) {
+        tcflush(masterFd, TCIFLUSH);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SocketTransport
+// ---------------------------------------------------------------------------
+
+SocketTransport::SocketTransport(Family family, const QString& address, quint16 port)
+    : family(family), address(address), port(port)
+{
+}
+
+SocketTransport::~SocketTransport()
+{
+    close();
+}
+
+QString SocketTransport::description() const
+{
+    if (family == Family::Unix) {
+        return "unix:" + address;
+    }
+    return QString("tcp:%1:%2").arg(address).arg(port);
+}
+
+bool SocketTransport::open()
+{
+    close();
+
+    // Whoever starts first listens; the second instance finds it and connects
+    if (tryConnect()) {
+        qDebug() << "Connected to link peer at" << description();
+        return true;
+    }
+    if (listen()) {
+        qDebug() << "Waiting for link peer on" << description();
+        return true;
+    }
+    return false;
+}
+
+void SocketTransport::close()
+{
+    if (connFd >= 0) {
+        ::close(connFd);
+        connFd = -1;
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        listenFd = -1;
+        if (family == Family::Unix) {
+            unlink(address.toLocal8Bit().constData());
+        }
+    }
+}
+
+bool SocketTransport::tryConnect()
+{
+    if (family == Family::Unix) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, address.toLocal8Bit().constData(), sizeof(addr.sun_path) - 1);
+
+        if (!connectWithTimeout(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr), kConnectTimeoutMs)) {
+            ::close(fd);
+            return false;
+        }
+        connFd = fd;
+        return true;
+    }
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *result = nullptr;
+    QByteArray portStr = QByteArray::number(port);
+    if (getaddrinfo(address.toLocal8Bit().constData(), portStr.constData(), &hints, &result) != 0) {
+        qDebug() << "Cannot resolve link host:" << address;
+        return false;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    // Runs on the GUI thread at startup, so an unreachable host must not hang the window
+    bool ok = fd >= 0 && connectWithTimeout(fd, result->ai_addr, result->ai_addrlen, kConnectTimeoutMs);
+    freeaddrinfo(result);
+    if (!ok) {
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+
+    // Packets are tiny; don't let Nagle hold them back
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    connFd = fd;
+    return true;
+}
+
+bool SocketTransport::listen()
+{
+    int fd = -1;
+
+    if (family == Family::Unix) {
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+
+        QByteArray path = address.toLocal8Bit();
+        unlink(path.constData());  // Stale socket from a previous run
+
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.constData(), sizeof(addr.sun_path) - 1);
+        if (::bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+            qDebug() << "Failed to bind link socket" << address << ":" << strerror(errno);
+            ::close(fd);
+            return false;
+        }
+    } else {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        if (inet_pton(AF_INET, address.toLocal8Bit().constData(), &addr.sin_addr) != 1) {
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        }
+        if (::bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+            qDebug() << "Failed to bind link port" << port << ":" << strerror(errno);
+            ::close(fd);
+            return false;
+        }
+    }
+
+    if (::listen(fd, 1) != 0) {
+        qDebug() << "Failed to listen on link socket:" << strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    setNonBlocking(fd);
+    listenFd = fd;
+    return true;
+}
+
+bool SocketTransport::acceptPending()
+{
+    if (connFd >= 0) return true;
+    if (listenFd < 0) return false;
+
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0) {
+        return false;  // EAGAIN: nobody there yet
+    }
+
+    if (family == Family::Tcp) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    setNonBlocking(fd);
+    connFd = fd;
+    qDebug() << "Link peer connected on" << description();
+    return true;
+}
+
+ssize_t SocketTransport::read(char *buffer, size_t size)
+{
+    if (connFd < 0) return 0;
+
+    ssize_t n = ::recv(connFd, buffer, size, 0);
+    if (n > 0) return n;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+
+    // Peer closed (n == 0) or the connection broke. Keep listening, if we
+    // were the listener, so the other instance can reconnect.
+    ::close(connFd);
+    connFd = -1;
+    errno = ECONNRESET;
+    return -1;
+}
+
+ssize_t SocketTransport::write(const char *data, size_t size)
+{
+    if (connFd < 0) {
+        errno = ENOTCONN;
+        return -1;
+    }
+    return ::send(connFd, data, size, MSG_NOSIGNAL);
+}
@@ -0,0 +1,141 @@
+#ifndef LINK_TRANSPORT_H
+#define LINK_TRANSPORT_H
+
+#include <QString>
+#include <sys/types.h>
+
+// Byte pipe underneath UartComm. The real boards talk over a UART; on a dev
+// machine two game instances can be linked through a pseudo-terminal or a
+// local socket instead. All backends use non-blocking file descriptors so the
+// owner can watch fd() with a QSocketNotifier (or poll()).
+class LinkTransport
+{
+public:
+    virtual ~LinkTransport() {}
+
+    // Build a transport from a link spec:
+    //   "/dev/ttyS1"           UART device (any path)
+    //   "pty"                  new pseudo-terminal; the slave path is logged so
+    //                          a second instance can open it as a UART
+    //   "tcp:host:port"        connect, or listen if nobody is there yet
+    //   "unix:/path/to/socket" same, over a UNIX domain socket
+    static LinkTransport *create(const QString& spec, qint32 baudRate = 115200);
+
+    virtual bool open() = 0;
+    virtual void close() = 0;
+
+    // True once bytes can flow. A listening socket is open but not connected
+    // until a peer arrives.
+    virtual bool isOpen() const = 0;
+    virtual bool isConnected() const { return isOpen(); }
+
+    // Descriptor to watch for readability. May change after acceptPending().
+    virtual int fd() const = 0;
+
+    // Listening backends: accept a waiting peer without blocking. Returns true
+    // if the transport is now connected.
+    virtual bool acceptPending() { return isConnected(); }
+
+    // Non-blocking read/write. read() returns 0 when no data is waiting and
+    // -1 on error or when the peer has gone away.
+    virtual ssize_t read(char *buffer, size_t size) = 0;
+    virtual ssize_t write(const char *data, size_t size) = 0;
+
+    // Block until queued output has left the device
+    virtual void drain() {}
+
+    // Only real serial lines have a baud rate worth negotiating
+    virtual bool supportsBaudRate(qint32 baudRate) const { Q_UNUSED(baudRate); return false; }
+    virtual bool setBaudRate(qint32 baudRate) { Q_UNUSED(baudRate); return false; }
+
+    // Drop any input that has arrived but not been read
+    virtual void flushInput() {}
+
+    virtual QString description() const = 0;
+};
+
+// termios serial port (also works on the slave side of a pty)
+class UartTransport : public LinkTransport
+{
+public:
+    UartTransport(const QString& portName, qint32 baudRate);
+    ~UartTransport() override;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return uartFd >= 0; }
+    int fd() const override { return uartFd; }
+    ssize_t read(char *buffer, size_t size) override;
+    ssize_t write(const char *data, size_t size) override;
+    void drain() override;
+    bool supportsBaudRate(qint32 baudRate) const override;
+    bool setBaudRate(qint32 baudRate) override;
+    void flushInput() override;
+    QString description() const override { return portName; }
+
+private:
+    QString portName;
+    qint32 baudRate;
+    int uartFd = -1;
+};
+
+// Master side of a new pseudo-terminal
+class PtyTransport : public LinkTransport
+{
+public:
+    PtyTransport() {}
+    ~PtyTransport() override;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return masterFd >= 0; }
+    int fd() const override { return masterFd; }
+    ssize_t read(char *buffer, size_t size) override;
+    ssize_t write(const char *data, size_t size) override;
+    void flushInput() override;
+    QString description() const override { return "pty " + slaveName; }
+
+    // Path the other end should open, e.g. /dev/pts/3
+    QString getSlaveName() const { return slaveName; }
+
+private:
+    int masterFd = -1;
+    int slaveFd = -1;  // Held open so the master doesn't see EIO between peers
+    QString slaveName;
+};
+
+// TCP or UNIX stream socket. The first instance to start listens, the second
+// connects to it.
+class SocketTransport : public LinkTransport
+{
+public:
+    enum class Family { Tcp, Unix };
+
+    SocketTransport(Family family, const QString& address, quint16 port = 0);
+    ~SocketTransport() override;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override { return listenFd >= 0 || connFd >= 0; }
+    bool isConnected() const override { return connFd >= 0; }
+    int fd() const override { return connFd >= 0 ? connFd : listenFd; }
+    bool acceptPending() override;
+    ssize_t read(char *buffer, size_t size) override;
+    ssize_t write(const char *data, size_t size) override;
+    QString description() const override;
+
+private:
+    Family family;
+    QString address;
+    quint16 port;
+    int listenFd = -1;
+    int connFd = -1;
+
+    // A peer that is up answers in well under this; otherwise we listen instead
+    static constexpr int kConnectTimeoutMs = 500;
+
+    bool tryConnect();
+    bool listen();
+};
+
+#endif // LINK_TRANSPORT_H
@@ -0,0 +1,128 @@
+#include "sprite_cache.h"
+#include "../Battle/SpriteAtlas_BT.h"
+#include "../Battle/Battle_logic/Pokemon.h"
+#include <QCoreApplication>
+#include <QDebug>
+
+SpriteCache::State::State()
+{
+    bool ok = false;
+    int kb = qEnvironmentVariableIntValue("POKELITE_SPRITE_CACHE_KB", &ok);
+    int budget = kDefaultBudgetKb;
+    if (ok && kb > 0) budget = kb;
+    cache.setMaxCost(budget);
+
+    // This outlives QApplication, but pixmaps must not; drop them while it is still up
+    if (QCoreApplication *app = QCoreApplication::instance()) {
+        QObject::connect(app, &QCoreApplication::aboutToQuit, [this]() { cache.clear(); });
+    }
+}
+
+SpriteCache::State& SpriteCache::state()
+{
+    static State s;
+    return s;
+}
+
+QString SpriteCache::pokemonKey(int dexNumber, bool front)
+{
+    return QString("pokemon:%1/%2").arg(dexNumber).arg(front ? "front" : "back");
+}
+
+QPixmap SpriteCache::lookup(const QString &key, bool prefetching, const std::function<QPixmap()> &load)
+{
+    State &s = state();
+    if (QPixmap *cached = s.cache.object(key)) {
+        if (!prefetching) ++s.hits;
+        return *cached;
+    }
+    if (!prefetching) ++s.misses;
+
+    QPixmap px = load();
+    if (px.isNull()) {
+        // Not cached, so a missing asset is retried (and logged) next time
+        return px;
+    }
+
+    // Cost is the decoded size in KB
+    const qint64 bytes = qint64(px.width()) * px.height() * qMax(1, px.depth() / 8);
+    const int cost = qMax<qint64>(1, bytes / 1024);
+    if (!s.cache.insert(key, new QPixmap(px), cost)) {
+        qDebug() << "Sprite" << key << "(" << cost << "KB) is larger than the sprite cache budget";
+    }
+    return px;
+}
+
+QPixmap SpriteCache::pokemon(const Pokemon *pokemon, bool front)
+{
+    if (!pokemon) {
+        return SpriteAtlas_BT::sprite(pokemon, front);
+    }
+    return lookup(pokemonKey(pokemon->getDexNumber(), front), false,
+                  [pokemon, front]() { return SpriteAtlas_BT::sprite(pokemon, front); });
+}
+
+QPixmap SpriteCache::pokemon(int dexNumber, bool front)
+{
+    return lookup(pokemonKey(dexNumber, front), false,
+                  [dexNumber, front]() { return SpriteAtlas_BT::sprite(dexNumber, front); });
+}
+
+QPixmap SpriteCache::pixmap(const QString &path)
+{
+    return lookup(path, false, [&path]() { return QPixmap(path); });
+}
+
+void SpriteCache::prefetchPokemon(int dexNumber, bool front)
+{
+    lookup(pokemonKey(dexNumber, front), true,
+           [dexNumber, front]() { return SpriteAtlas_BT::sprite(dexNumber, front); });
+}
+
+void SpriteCache::prefetch(const QString &path)
+{
+    lookup(path, true, [&path]() { return QPixmap(path); });
+}
+
+int SpriteCache::budgetKb()
+{
+    return state().cache.maxCost();
+}
+
+void SpriteCache::setBudgetKb(int kb)
+{
+    // Shrinking evicts least recently used sprites straight away
+    state().cache.setMaxCost(qMax(1, kb));
+}
+
+int SpriteCache::usedKb()
+{
+    return state().cache.totalCost();
+}
+
+int SpriteCache::count()
+{
+    return state().cache.count();
+}
+
+quint64 SpriteCache::hits()
+{
+    return state().hits;
+}
+
+quint64 SpriteCache::misses()
+{
+    return state().misses;
+}
+
+void SpriteCache::resetCounters()
+{
+    State &s = state();
+    s.hits = 0;
+    s.misses = 0;
+}
+
+void SpriteCache::clear()
+{
+    state().cache.clear();
+}
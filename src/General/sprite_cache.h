@@ -0,0 +1,57 @@
+#ifndef SPRITE_CACHE_H
+#define SPRITE_CACHE_H
+
+#include <QPixmap>
+#include <QString>
+#include <QCache>
+#include <functional>
+
+class Pokemon;
+
+// Decoded sprites shared by every battle and screen. Lookups that miss are
+// loaded (Pokemon through SpriteAtlas_BT, everything else from its path) and
+// kept until the least recently used ones have to make room under the memory
+// budget. POKELITE_SPRITE_CACHE_KB sets the budget; the default is 8 MB.
+//
+// GUI thread only, like QPixmap itself. Emptied when the application is
+// about to quit, so no pixmap outlives QApplication.
+class SpriteCache
+{
+public:
+    // Pokemon sprites, keyed by dex number and facing
+    static QPixmap pokemon(const Pokemon *pokemon, bool front);
+    static QPixmap pokemon(int dexNumber, bool front);
+
+    // Trainer, pokeball, UI frames and anything else with a resource path
+    static QPixmap pixmap(const QString &path);
+
+    // Load now so a later lookup hits. Prefetches don't count as hits or misses.
+    static void prefetchPokemon(int dexNumber, bool front);
+    static void prefetch(const QString &path);
+
+    static int budgetKb();
+    static void setBudgetKb(int kb);
+    static int usedKb();
+    static int count();
+
+    static quint64 hits();
+    static quint64 misses();
+    static void resetCounters();
+    static void clear();
+
+private:
+    struct State {
+        State();
+        QCache<QString, QPixmap> cache;
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    static constexpr int kDefaultBudgetKb = 8 * 1024;
+
+    static State& state();
+    static QString pokemonKey(int dexNumber, bool front);
+    static QPixmap lookup(const QString &key, bool prefetching, const std::function<QPixmap()> &load);
+};
+
+#endif // SPRITE_CACHE_H
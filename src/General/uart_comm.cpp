@@ -1,14 +1,39 @@
 #include "uart_comm.h"
+#include "link_io_thread.h"
+#include "frame_profiler.h"
 #include <QDebug>
 #include <QByteArray>
-#include <fcntl.h>
-#include <unistd.h>
-#include <termios.h>
-#include <errno.h>
-#include <string.h>
+#include <QStringList>
+#include <QRandomGenerator>
 
-// Serialize packet to string format: "TYPE:data\n"
-QString BattlePacket::serialize() const
+// Rates tried during negotiation, lowest first. The AM335x UART divides a
+// 48 MHz clock by 16, so 3 Mbaud is the fastest standard rate it hits exactly.
+static const qint32 kBaudLadder[] = { 115200, 230400, 460800, 921600, 1500000, 3000000 };
+
+static const int kProbeCount = 16;              // BAUD_PROBE packets per step
+static const double kMaxProbeErrorRate = 0.07;  // Accept a step with at most 1 lost probe
+static const int kHandshakeTimeoutMs = 300;     // Per-step reply timeout
+static const int kRateSettleMs = 20;            // Give the peer time to reprogram its UART
+static const int kFallbackErrorThreshold = 3;   // Consecutive bad packets before falling back
+
+static const int kPingIntervalMs = 2000;        // Link RTT sample period
+static const int kDefaultStatsLogMs = 30000;    // Periodic LinkStats dump
+
+// CRC-16/CCITT-FALSE over the packet body
+static quint16 crc16(const QByteArray& bytes)
+{
+    quint16 crc = 0xFFFF;
+    for (char c : bytes) {
+        crc ^= static_cast<quint16>(static_cast<quint8>(c)) << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<quint16>((crc << 1) ^ 0x1021)
+                                 : static_cast<quint16>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+QString BattlePacket::typeName(PacketType type)
 {
     QString typeStr;
     switch (type) {
@@ -39,27 +64,75 @@ QString BattlePacket::serialize() const
         case PacketType::POKEMON_DATA:
             typeStr = "POKEMON_DATA";
             break;
+        case PacketType::RESYNC_HASH:
+            typeStr = "RESYNC_HASH";
+            break;
+        case PacketType::RESYNC_STATE:
+            typeStr = "RESYNC_STATE";
+            break;
+        case PacketType::BAUD_PROPOSE:
+            typeStr = "BAUD_PROPOSE";
+            break;
+        case PacketType::BAUD_ACK:
+            typeStr = "BAUD_ACK";
+            break;
+        case PacketType::BAUD_PROBE:
+            typeStr = "BAUD_PROBE";
+            break;
+        case PacketType::BAUD_RESULT:
+            typeStr = "BAUD_RESULT";
+            break;
+        case PacketType::BAUD_CONFIRM:
+            typeStr = "BAUD_CONFIRM";
+            break;
+        case PacketType::BAUD_FALLBACK:
+            typeStr = "BAUD_FALLBACK";
+            break;
+        case PacketType::PING:
+            typeStr = "PING";
+            break;
+        case PacketType::PONG:
+            typeStr = "PONG";
+            break;
         default:
             typeStr = "INVALID";
             break;
     }
+    return typeStr;
+}
+
+// Serialize packet to string format: "TYPE:data*CRC\n"
+QString BattlePacket::serialize() const
+{
+    QString typeStr = typeName(type);
     
-    if (data.isEmpty()) {
-        return typeStr + "\n";
-    } else {
-        return typeStr + ":" + data + "\n";
-    }
+    QString body = data.isEmpty() ? typeStr : typeStr + ":" + data;
+    quint16 crc = crc16(body.toUtf8());
+    return body + "*" + QString("%1").arg(crc, 4, 16, QChar('0')).toUpper() + "\n";
 }
 
 // Deserialize string to packet
-BattlePacket BattlePacket::deserialize(const QString& str)
+BattlePacket BattlePacket::deserialize(const QString& str, bool *crcOk)
 {
     BattlePacket packet;
+    if (crcOk) *crcOk = true;
     
     QString trimmed = str.trimmed();
     if (trimmed.isEmpty()) {
         return packet;
     }
+
+    // Strip and verify the "*XXXX" CRC suffix if present
+    int crcIndex = trimmed.lastIndexOf('*');
+    if (crcIndex >= 0 && trimmed.size() - crcIndex == 5) {
+        bool okHex = false;
+        quint16 expected = static_cast<quint16>(trimmed.mid(crcIndex + 1).toUInt(&okHex, 16));
+        trimmed = trimmed.left(crcIndex);
+        if (!okHex || crc16(trimmed.toUtf8()) != expected) {
+            if (crcOk) *crcOk = false;
+            return packet;
+        }
+    }
     
     int colonIndex = trimmed.indexOf(':');
     QString typeStr;
@@ -91,6 +164,26 @@ BattlePacket BattlePacket::deserialize(const QString& str)
         packet.type = PacketType::BATTLE_END;
     } else if (typeStr == "POKEMON_DATA") {
         packet.type = PacketType::POKEMON_DATA;
+    } else if (typeStr == "RESYNC_HASH") {
+        packet.type = PacketType::RESYNC_HASH;
+    } else if (typeStr == "RESYNC_STATE") {
+        packet.type = PacketType::RESYNC_STATE;
+    } else if (typeStr == "BAUD_PROPOSE") {
+        packet.type = PacketType::BAUD_PROPOSE;
+    } else if (typeStr == "BAUD_ACK") {
+        packet.type = PacketType::BAUD_ACK;
+    } else if (typeStr == "BAUD_PROBE") {
+        packet.type = PacketType::BAUD_PROBE;
+    } else if (typeStr == "BAUD_RESULT") {
+        packet.type = PacketType::BAUD_RESULT;
+    } else if (typeStr == "BAUD_CONFIRM") {
+        packet.type = PacketType::BAUD_CONFIRM;
+    } else if (typeStr == "BAUD_FALLBACK") {
+        packet.type = PacketType::BAUD_FALLBACK;
+    } else if (typeStr == "PING") {
+        packet.type = PacketType::PING;
+    } else if (typeStr == "PONG") {
+        packet.type = PacketType::PONG;
     } else {
         packet.type = PacketType::INVALID;
     }
@@ -99,12 +192,47 @@ BattlePacket BattlePacket::deserialize(const QString& str)
     return packet;
 }
 
+bool BattlePacket::isLinkControl() const
+{
+    switch (type) {
+        case PacketType::BAUD_PROPOSE:
+        case PacketType::BAUD_ACK:
+        case PacketType::BAUD_PROBE:
+        case PacketType::BAUD_RESULT:
+        case PacketType::BAUD_CONFIRM:
+        case PacketType::BAUD_FALLBACK:
+        case PacketType::PING:
+        case PacketType::PONG:
+            return true;
+        default:
+            return false;
+    }
+}
+
 UartComm::UartComm(QObject *parent)
-    : QObject(parent), uartFd(-1), readNotifier(nullptr), findingPlayerTimer(nullptr),
-      findingPlayer(false)
+    : QObject(parent), transport(nullptr), ioThread(nullptr),
+      linkConnected(false), peerActive(false), findingPlayerTimer(nullptr), findingPlayer(false),
+      negotiationTimer(nullptr), pingTimer(nullptr), statsLogTimer(nullptr)
 {
     findingPlayerTimer = new QTimer(this);
     connect(findingPlayerTimer, &QTimer::timeout, this, &UartComm::sendFindingPlayerPacket);
+
+    negotiationTimer = new QTimer(this);
+    negotiationTimer->setSingleShot(true);
+    connect(negotiationTimer, &QTimer::timeout, this, &UartComm::onNegotiationTimeout);
+
+    pingTimer = new QTimer(this);
+    pingTimer->setInterval(kPingIntervalMs);
+    connect(pingTimer, &QTimer::timeout, this, &UartComm::sendPing);
+
+    statsLogTimer = new QTimer(this);
+    statsLogTimer->setInterval(kDefaultStatsLogMs);
+    connect(statsLogTimer, &QTimer::timeout, this, [this]() {
+        if (isConnected()) dumpLinkStats();
+    });
+
+    linkClock.start();
+    statsClock.start();
 }
 
 UartComm::~UartComm()
@@ -116,119 +244,110 @@ bool UartComm::initialize(const QString& portName, qint32 baudRate)
 {
     // Close existing connection if any
     close();
-    
-    // Open UART device
-    QByteArray portBytes = portName.toLocal8Bit();
-    uartFd = ::open(portBytes.constData(), O_RDWR | O_NOCTTY | O_NONBLOCK);
-    
-    if (uartFd < 0) {
-        qDebug() << "Failed to open UART port:" << portName << "Error:" << strerror(errno);
-        emit connectionStatusChanged(false);
-        return false;
-    }
-    
-    // Configure serial port using termios
-    struct termios tty;
-    if (tcgetattr(uartFd, &tty) != 0) {
-        qDebug() << "Failed to get UART attributes:" << strerror(errno);
-        ::close(uartFd);
-        uartFd = -1;
+
+    transport = LinkTransport::create(portName, baudRate);
+    if (!transport || !transport->open()) {
+        qDebug() << "Failed to open link:" << portName;
+        delete transport;
+        transport = nullptr;
         emit connectionStatusChanged(false);
         return false;
     }
-    
-    // Set baud rate
-    speed_t speed;
-    switch (baudRate) {
-        case 9600: speed = B9600; break;
-        case 19200: speed = B19200; break;
-        case 38400: speed = B38400; break;
-        case 57600: speed = B57600; break;
-        case 115200: speed = B115200; break;
-        case 230400: speed = B230400; break;
-        default: speed = B115200; break;
+
+    if (!transport->supportsBaudRate(baudRate)) {
+        baudRate = 115200;
     }
-    
-    cfsetospeed(&tty, speed);
-    cfsetispeed(&tty, speed);
-    
-    // 8N1 configuration
-    tty.c_cflag &= ~PARENB;  // No parity
-    tty.c_cflag &= ~CSTOPB;  // 1 stop bit
-    tty.c_cflag &= ~CSIZE;   // Clear size bits
-    tty.c_cflag |= CS8;      // 8 data bits
-    tty.c_cflag &= ~CRTSCTS; // No hardware flow control
-    tty.c_cflag |= CREAD | CLOCAL; // Enable receiver, ignore modem control lines
-    
-    // Disable canonical mode (raw input)
-    tty.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-    
-    // Disable software flow control
-    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
-    
-    // Raw output
-    tty.c_oflag &= ~OPOST;
-    
-    // Set read timeout (0.1 seconds)
-    tty.c_cc[VMIN] = 0;
-    tty.c_cc[VTIME] = 1;
-    
-    // Apply settings
-    if (tcsetattr(uartFd, TCSANOW, &tty) != 0) {
-        qDebug() << "Failed to set UART attributes:" << strerror(errno);
-        ::close(uartFd);
-        uartFd = -1;
-        emit connectionStatusChanged(false);
-        return false;
+    baseBaudRate = baudRate;
+    currentBaudRate = baudRate;
+    previousBaudRate = baudRate;
+    linkConnected = transport->isConnected();
+
+    // From here on only the I/O thread touches the transport's descriptors
+    ioThread = new LinkIoThread(transport);
+    // Received packets are picked up when the I/O thread has some, not polled
+    connect(ioThread, &LinkIoThread::eventsReady, this, &UartComm::pumpLink, Qt::QueuedConnection);
+    ioThread->start();
+    resetLinkStats();
+
+    qDebug() << "Link opened successfully:" << transport->description();
+    if (linkConnected) {
+        emit connectionStatusChanged(true);
     }
-    
-    // Create socket notifier for async reading
-    readNotifier = new QSocketNotifier(uartFd, QSocketNotifier::Read, this);
-    connect(readNotifier, &QSocketNotifier::activated, this, &UartComm::handleReadyRead);
-    readNotifier->setEnabled(true);
-    
-    qDebug() << "UART port opened successfully:" << portName;
-    emit connectionStatusChanged(true);
     return true;
 }
 
 void UartComm::close()
 {
     stopFindingPlayer();
+    negotiationTimer->stop();
+    negotiationState = NegotiationState::Idle;
+    deferredPackets.clear();
+    linkErrorCount = 0;
+    stopPeerTimers();
     
-    if (readNotifier) {
-        readNotifier->setEnabled(false);
-        delete readNotifier;
-        readNotifier = nullptr;
+    if (ioThread) {
+        ioThread->stop();
+        delete ioThread;
+        ioThread = nullptr;
     }
     
-    if (uartFd >= 0) {
-        ::close(uartFd);
-        uartFd = -1;
-        emit connectionStatusChanged(false);
+    if (transport) {
+        transport->close();
+        delete transport;
+        transport = nullptr;
+        if (linkConnected) {
+            linkConnected = false;
+            emit connectionStatusChanged(false);
+        }
     }
 }
 
 bool UartComm::sendPacket(const BattlePacket& packet)
 {
-    if (uartFd < 0) {
-        qDebug() << "Cannot send packet: UART not open";
+    if (!isConnected()) {
+        qDebug() << "Cannot send packet: link not connected";
+        return false;
+    }
+
+    // Hold game packets back while the two ends may be at different rates
+    if (isNegotiating() && !packet.isLinkControl()) {
+        deferredPackets.append(packet);
+        stats.deferredHighWater = qMax(stats.deferredHighWater, deferredPackets.size());
+        return true;
+    }
+
+    return writePacket(packet);
+}
+
+bool UartComm::writePacket(const BattlePacket& packet)
+{
+    PROFILE_ZONE("uart.send");
+    if (!isConnected() || !ioThread) {
         return false;
     }
     
     QString packetStr = packet.serialize();
-    QByteArray data = packetStr.toUtf8();
-    
-    ssize_t bytesWritten = ::write(uartFd, data.constData(), data.size());
-    if (bytesWritten < 0) {
-        qDebug() << "Error writing to UART:" << strerror(errno);
+    LinkCommand command;
+    command.kind = LinkCommand::Kind::Write;
+    command.bytes = packetStr.toUtf8();
+    if (!ioThread->post(std::move(command))) {
         return false;
     }
+
+    stats.packetsSent[BattlePacket::typeName(packet.type)]++;
+    stats.txQueueHighWater = qMax(stats.txQueueHighWater, ioThread->commandQueueDepth());
     
-    // Ensure data is written
-    tcdrain(uartFd);
-    
-    qDebug() << "Sent packet:" << packetStr.trimmed();
+    // PING/PONG every couple of seconds would drown out the useful lines
+    if (packet.type != PacketType::PING && packet.type != PacketType::PONG) {
+        qDebug() << "Sent packet:" << packetStr.trimmed();
+    }
+    return true;
+}
+
+bool UartComm::resendPacket(const BattlePacket& packet)
+{
+    if (!sendPacket(packet)) return false;
+    stats.retransmits++;
     return true;
 }
 
@@ -253,59 +372,455 @@ void UartComm::sendFindingPlayerPacket()
 {
     if (findingPlayer && isConnected()) {
         BattlePacket packet(PacketType::FINDING_PLAYER);
-        sendPacket(packet);
+        // Timer-driven repeats mean the previous broadcast went unanswered
+        if (findingPlayerTimer->isActive()) {
+            resendPacket(packet);
+        } else {
+            sendPacket(packet);
+        }
     }
 }
 
-void UartComm::handleReadyRead()
+void UartComm::pumpLink()
 {
-    if (uartFd < 0) return;
+    PROFILE_ZONE("uart.pump");
+    if (ioThread) {
+        stats.rxQueueHighWater = qMax(stats.rxQueueHighWater, ioThread->eventQueueDepth());
+    }
+
+    if (!ioThread) return;
+    ioThread->acknowledgeEvents();
+
+    LinkEvent event;
+    while (ioThread && ioThread->nextEvent(event)) {
+        handleLinkEvent(event);
+    }
+}
+
+void UartComm::handleLinkEvent(const LinkEvent& event)
+{
+    switch (event.kind) {
+        case LinkEvent::Kind::Connected:
+            linkConnected = true;
+            emit connectionStatusChanged(true);
+            return;
+
+        case LinkEvent::Kind::Disconnected:
+            // Socket listener survives its peer; wait for the next one
+            linkConnected = false;
+            stopPeerTimers();
+            negotiationTimer->stop();
+            negotiationState = NegotiationState::Idle;
+            deferredPackets.clear();
+            emit connectionStatusChanged(false);
+            return;
+
+        case LinkEvent::Kind::Failed:
+            close();
+            return;
+
+        case LinkEvent::Kind::BadPacket:
+            if (event.crcOk) {
+                stats.parseFailures++;
+            } else {
+                stats.crcFailures++;
+            }
+            qDebug() << (event.crcOk ? "Unparseable link line:" : "CRC mismatch on link line:") << event.raw;
+            handleLinkError();
+            return;
+
+        case LinkEvent::Kind::Packet:
+            break;
+    }
+
+    const BattlePacket& packet = event.packet;
+    linkErrorCount = 0;
+    // Anything well-formed means someone is on the other end
+    startPeerTimers();
+    stats.packetsReceived[BattlePacket::typeName(packet.type)]++;
+
+    if (packet.isLinkControl()) {
+        handleLinkControlPacket(packet);
+        return;
+    }
+    
+    qDebug() << "Received packet:" << event.raw;
     
-    char buffer[256];
-    ssize_t bytesRead = ::read(uartFd, buffer, sizeof(buffer) - 1);
+    // Emit packetReceived FIRST so data can be parsed before playerFound signal
+    emit packetReceived(packet);
     
-    if (bytesRead > 0) {
-        buffer[bytesRead] = '\0';
-        receiveBuffer += QString::fromUtf8(buffer, bytesRead);
-        
-        // Parse complete packets (ending with \n)
-        parseReceivedData();
-    } else if (bytesRead < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
-        qDebug() << "Error reading from UART:" << strerror(errno);
-        close();
-    }
-}
-
-void UartComm::parseReceivedData()
-{
-    while (receiveBuffer.contains('\n')) {
-        int newlineIndex = receiveBuffer.indexOf('\n');
-        QString line = receiveBuffer.left(newlineIndex);
-        receiveBuffer = receiveBuffer.mid(newlineIndex + 1);
-        
-        if (!line.isEmpty()) {
-            BattlePacket packet = BattlePacket::deserialize(line);
-            
-            if (packet.type != PacketType::INVALID) {
-                qDebug() << "Received packet:" << line;
-                
-                // Emit packetReceived FIRST so data can be parsed before playerFound signal
-                emit packetReceived(packet);
-                
-                // Handle READY_BATTLE specially - emit playerFound AFTER data is parsed
-                if (packet.type == PacketType::READY_BATTLE) {
-                    // Stop searching once someone is ready to battle
-                    stopFindingPlayer();
-                    // Emit playerFound AFTER packetReceived so Window::onUartPacketReceived
-                    // has a chance to parse and store the Pokemon data first
-                    emit playerFound();
-                }
-                
-                // Note: FINDING_PLAYER response with Pokemon data is now handled in Window::onUartPacketReceived
-                // to ensure Pokemon data is included in the READY_BATTLE response
+    // Handle READY_BATTLE specially - emit playerFound AFTER data is parsed
+    if (packet.type == PacketType::READY_BATTLE) {
+        // Stop searching once someone is ready to battle
+        stopFindingPlayer();
+        // Emit playerFound AFTER packetReceived so Window::onUartPacketReceived
+        // has a chance to parse and store the Pokemon data first
+        emit playerFound();
+    }
+    
+    // Note: FINDING_PLAYER response with Pokemon data is now handled in Window::onUartPacketReceived
+    // to ensure Pokemon data is included in the READY_BATTLE response
+}
+
+bool UartComm::applyBaudRate(qint32 baudRate)
+{
+    if (!transport || !ioThread || !transport->supportsBaudRate(baudRate)) return false;
+
+    LinkCommand command;
+    command.kind = LinkCommand::Kind::SetBaudRate;
+    command.baudRate = baudRate;
+    if (!ioThread->post(std::move(command))) return false;
+
+    currentBaudRate = baudRate;
+    linkErrorCount = 0;
+    return true;
+}
+
+void UartComm::startBaudNegotiation()
+{
+    if (!isConnected() || isNegotiating()) return;
+    // Sockets and pty masters have no line rate to tune
+    if (!transport->supportsBaudRate(currentBaudRate)) return;
+
+    negotiationNonce = QRandomGenerator::global()->generate();
+    previousBaudRate = currentBaudRate;
+    proposeNextBaudRate();
+}
+
+void UartComm::proposeNextBaudRate()
+{
+    pendingBaudRate = 0;
+    for (qint32 rate : kBaudLadder) {
+        if (rate > currentBaudRate && rate <= maxBaudRate && transport->supportsBaudRate(rate)) {
+            pendingBaudRate = rate;
+            break;
+        }
+    }
+
+    if (pendingBaudRate == 0) {
+        finishNegotiation();
+        return;
+    }
+
+    negotiationState = NegotiationState::Proposing;
+    writePacket(BattlePacket(PacketType::BAUD_PROPOSE,
+                             QString("%1,%2").arg(pendingBaudRate).arg(negotiationNonce)));
+    negotiationTimer->start(kHandshakeTimeoutMs);
+}
+
+void UartComm::sendBaudProbes()
+{
+    if (negotiationState != NegotiationState::AwaitingResult) return;
+
+    for (int i = 0; i < kProbeCount; ++i) {
+        writePacket(BattlePacket(PacketType::BAUD_PROBE, QString::number(i)));
+    }
+    negotiationTimer->start(kHandshakeTimeoutMs);
+}
+
+void UartComm::handleLinkControlPacket(const BattlePacket& packet)
+{
+    switch (packet.type) {
+        case PacketType::PING:
+            // Echo back untouched; the sender timestamps against its own clock
+            if (!isNegotiating()) {
+                writePacket(BattlePacket(PacketType::PONG, packet.data));
             }
+            break;
+
+        case PacketType::PONG: {
+            QStringList parts = packet.data.split(',');
+            bool ok = false;
+            qint64 sentMicros = parts.value(1).toLongLong(&ok);
+            if (ok) {
+                stats.pongsReceived++;
+                recordRtt((linkClock.nsecsElapsed() / 1000 - sentMicros) / 1000.0);
+            }
+            break;
         }
+
+        case PacketType::BAUD_PROPOSE: {
+            QStringList parts = packet.data.split(',');
+            qint32 rate = parts.value(0).toInt();
+            quint32 nonce = parts.value(1).toUInt();
+
+            // Both sides proposed at once: the higher nonce keeps the initiator role
+            if (negotiationState == NegotiationState::Proposing) {
+                if (negotiationNonce > nonce) return;
+                negotiationTimer->stop();
+            } else if (isNegotiating()) {
+                return;
+            }
+
+            if (rate <= currentBaudRate || rate > maxBaudRate || !transport->supportsBaudRate(rate)) {
+                // Refuse; the initiator stops at its current rate
+                writePacket(BattlePacket(PacketType::BAUD_RESULT, "0"));
+                finishNegotiation();
+                return;
+            }
+
+            // ACK goes out at the old rate (writePacket drains) before we switch
+            previousBaudRate = currentBaudRate;
+            pendingBaudRate = rate;
+            writePacket(BattlePacket(PacketType::BAUD_ACK, QString::number(rate)));
+            if (!applyBaudRate(rate)) {
+                finishNegotiation();
+                return;
+            }
+            probesReceived = 0;
+            negotiationState = NegotiationState::AwaitingProbes;
+            negotiationTimer->start(kHandshakeTimeoutMs);
+            break;
+        }
+
+        case PacketType::BAUD_ACK:
+            if (negotiationState != NegotiationState::Proposing) return;
+            negotiationTimer->stop();
+            if (!applyBaudRate(pendingBaudRate)) {
+                // Peer already switched; wait for it to time out and come back
+                negotiationState = NegotiationState::AwaitingResult;
+                negotiationTimer->start(kHandshakeTimeoutMs);
+                return;
+            }
+            negotiationState = NegotiationState::AwaitingResult;
+            QTimer::singleShot(kRateSettleMs, this, &UartComm::sendBaudProbes);
+            break;
+
+        case PacketType::BAUD_PROBE:
+            if (negotiationState != NegotiationState::AwaitingProbes) return;
+            probesReceived++;
+            if (packet.data.toInt() >= kProbeCount - 1) {
+                negotiationTimer->stop();
+                writePacket(BattlePacket(PacketType::BAUD_RESULT, QString::number(probesReceived)));
+                negotiationState = NegotiationState::AwaitingConfirm;
+                negotiationTimer->start(kHandshakeTimeoutMs);
+            }
+            break;
+
+        case PacketType::BAUD_RESULT: {
+            if (negotiationState == NegotiationState::Proposing) {
+                // Peer refused the proposal
+                negotiationTimer->stop();
+                finishNegotiation();
+                return;
+            }
+            if (negotiationState != NegotiationState::AwaitingResult) return;
+            negotiationTimer->stop();
+
+            int good = qBound(0, packet.data.toInt(), kProbeCount);
+            double errorRate = 1.0 - static_cast<double>(good) / kProbeCount;
+            baudErrorRates[pendingBaudRate] = errorRate;
+            qDebug() << "Baud probe at" << pendingBaudRate << "error rate:" << errorRate;
+
+            if (errorRate <= kMaxProbeErrorRate) {
+                writePacket(BattlePacket(PacketType::BAUD_CONFIRM, QString::number(pendingBaudRate)));
+                previousBaudRate = currentBaudRate;
+                emit baudRateChanged(currentBaudRate);
+                proposeNextBaudRate();
+            } else {
+                // Peer reverts on its own when the confirm never arrives
+                applyBaudRate(previousBaudRate);
+                QTimer::singleShot(kHandshakeTimeoutMs + kRateSettleMs, this, &UartComm::finishNegotiation);
+            }
+            break;
+        }
+
+        case PacketType::BAUD_CONFIRM:
+            if (negotiationState != NegotiationState::AwaitingConfirm) return;
+            negotiationTimer->stop();
+            baudErrorRates[currentBaudRate] = 1.0 - static_cast<double>(probesReceived) / kProbeCount;
+            previousBaudRate = currentBaudRate;
+            emit baudRateChanged(currentBaudRate);
+            // The initiator may propose another step; until then the link is usable
+            finishNegotiation();
+            break;
+
+        case PacketType::BAUD_FALLBACK:
+            qDebug() << "Peer requested fallback to" << baseBaudRate << "baud";
+            negotiationTimer->stop();
+            if (currentBaudRate != baseBaudRate && applyBaudRate(baseBaudRate)) {
+                emit baudRateChanged(currentBaudRate);
+            }
+            previousBaudRate = baseBaudRate;
+            finishNegotiation();
+            break;
+
+        default:
+            break;
     }
 }
 
+void UartComm::onNegotiationTimeout()
+{
+    switch (negotiationState) {
+        case NegotiationState::Proposing:
+            // Peer never answered (older build or not listening); stay where we are
+            qDebug() << "No reply to baud proposal, staying at" << currentBaudRate;
+            finishNegotiation();
+            break;
+
+        case NegotiationState::AwaitingProbes:
+            if (probesReceived > 0) {
+                // Last probe was lost; report what arrived
+                writePacket(BattlePacket(PacketType::BAUD_RESULT, QString::number(probesReceived)));
+                negotiationState = NegotiationState::AwaitingConfirm;
+                negotiationTimer->start(kHandshakeTimeoutMs);
+                return;
+            }
+            // fall through
+        case NegotiationState::AwaitingResult:
+        case NegotiationState::AwaitingConfirm:
+            qDebug() << "Baud negotiation at" << pendingBaudRate << "timed out, reverting to" << previousBaudRate;
+            baudErrorRates[pendingBaudRate] = 1.0;
+            applyBaudRate(previousBaudRate);
+            finishNegotiation();
+            break;
 
+        case NegotiationState::Idle:
+            break;
+    }
+}
+
+void UartComm::finishNegotiation()
+{
+    negotiationTimer->stop();
+    negotiationState = NegotiationState::Idle;
+    pendingBaudRate = 0;
+    qDebug() << "UART link running at" << currentBaudRate << "baud";
+    flushDeferredPackets();
+}
+
+void UartComm::flushDeferredPackets()
+{
+    QList<BattlePacket> pending = deferredPackets;
+    deferredPackets.clear();
+    for (const BattlePacket& packet : pending) {
+        writePacket(packet);
+    }
+}
+
+void UartComm::handleLinkError()
+{
+    // Lost probes are already accounted for by the negotiation itself
+    if (isNegotiating()) return;
+
+    linkErrorCount++;
+    if (linkErrorCount < kFallbackErrorThreshold || currentBaudRate == baseBaudRate) return;
+
+    qDebug() << "Repeated UART errors at" << currentBaudRate << "baud, falling back to" << baseBaudRate;
+    // Best effort: the peer also falls back on its own once it sees the same errors
+    writePacket(BattlePacket(PacketType::BAUD_FALLBACK));
+    if (applyBaudRate(baseBaudRate)) {
+        previousBaudRate = baseBaudRate;
+        emit baudRateChanged(currentBaudRate);
+    }
+}
+
+void UartComm::sendPing()
+{
+    // A ping sent mid-negotiation could go out at the wrong rate
+    if (!isConnected() || isNegotiating()) return;
+
+    qint64 nowMicros = linkClock.nsecsElapsed() / 1000;
+    if (writePacket(BattlePacket(PacketType::PING, QString("%1,%2").arg(++pingSeq).arg(nowMicros)))) {
+        stats.pingsSent++;
+    }
+}
+
+void UartComm::startPeerTimers()
+{
+    if (peerActive) return;
+
+    peerActive = true;
+    pingTimer->start();
+    if (statsLogTimer->interval() > 0) {
+        statsLogTimer->start();
+    }
+}
+
+void UartComm::stopPeerTimers()
+{
+    peerActive = false;
+    pingTimer->stop();
+    statsLogTimer->stop();
+}
+
+void UartComm::recordRtt(double rttMs)
+{
+    if (rttMs < 0.0) return;
+
+    stats.lastRttMs = rttMs;
+    if (stats.pongsReceived == 1) {
+        stats.minRttMs = rttMs;
+        stats.maxRttMs = rttMs;
+        stats.avgRttMs = rttMs;
+    } else {
+        stats.minRttMs = qMin(stats.minRttMs, rttMs);
+        stats.maxRttMs = qMax(stats.maxRttMs, rttMs);
+        stats.avgRttMs = stats.avgRttMs * 0.875 + rttMs * 0.125;
+    }
+}
+
+LinkStats UartComm::linkStats() const
+{
+    LinkStats snapshot = stats;
+    snapshot.deferredHighWater = qMax(snapshot.deferredHighWater, deferredPackets.size());
+    snapshot.elapsedMs = statsClock.elapsed();
+    if (ioThread) {
+        snapshot.bytesSent = ioThread->getBytesWritten();
+        snapshot.bytesReceived = ioThread->getBytesRead();
+        snapshot.txQueueDepth = ioThread->commandQueueDepth();
+        snapshot.rxQueueDepth = ioThread->eventQueueDepth();
+        snapshot.rxQueueHighWater = qMax(snapshot.rxQueueHighWater, ioThread->eventQueueHighWater());
+    }
+    return snapshot;
+}
+
+void UartComm::resetLinkStats()
+{
+    stats = LinkStats();
+    statsClock.restart();
+    if (ioThread) {
+        ioThread->resetCounters();
+    }
+}
+
+void UartComm::setStatsLogInterval(int ms)
+{
+    statsLogTimer->stop();
+    statsLogTimer->setInterval(ms);
+    if (ms > 0 && peerActive) {
+        statsLogTimer->start();
+    }
+}
+
+void UartComm::dumpLinkStats() const
+{
+    LinkStats s = linkStats();
+    double seconds = qMax<qint64>(s.elapsedMs, 1) / 1000.0;
+
+    qDebug().noquote() << QString("Link stats (%1, %2 baud, %3 s): tx %4 B (%5 B/s), rx %6 B (%7 B/s)")
+                              .arg(getLinkDescription()).arg(currentBaudRate).arg(seconds, 0, 'f', 1)
+                              .arg(s.bytesSent).arg(s.bytesSent / seconds, 0, 'f', 0)
+                              .arg(s.bytesReceived).arg(s.bytesReceived / seconds, 0, 'f', 0);
+    qDebug().noquote() << QString("  rtt last/avg/min/max %1/%2/%3/%4 ms (%5 of %6 pings answered)")
+                              .arg(s.lastRttMs, 0, 'f', 1).arg(s.avgRttMs, 0, 'f', 1)
+                              .arg(s.minRttMs, 0, 'f', 1).arg(s.maxRttMs, 0, 'f', 1)
+                              .arg(s.pongsReceived).arg(s.pingsSent);
+    qDebug().noquote() << QString("  crc failures %1, parse failures %2, retransmits %3")
+                              .arg(s.crcFailures).arg(s.parseFailures).arg(s.retransmits);
+    qDebug().noquote() << QString("  queues tx %1 (peak %2), rx %3 (peak %4), deferred peak %5")
+                              .arg(s.txQueueDepth).arg(s.txQueueHighWater)
+                              .arg(s.rxQueueDepth).arg(s.rxQueueHighWater).arg(s.deferredHighWater);
+
+    QStringList sent;
+    for (auto it = s.packetsSent.constBegin(); it != s.packetsSent.constEnd(); ++it) {
+        sent << QString("%1=%2").arg(it.key()).arg(it.value());
+    }
+    QStringList received;
+    for (auto it = s.packetsReceived.constBegin(); it != s.packetsReceived.constEnd(); ++it) {
+        received << QString("%1=%2").arg(it.key()).arg(it.value());
+    }
+    qDebug().noquote() << "  sent:" << sent.join(' ');
+    qDebug().noquote() << "  received:" << received.join(' ');
+}
@@ -4,7 +4,13 @@
 #include <QObject>
 #include <QTimer>
 #include <QString>
-#include <QSocketNotifier>
+#include <QList>
+#include <QMap>
+#include <QElapsedTimer>
+#include "link_transport.h"
+
+class LinkIoThread;
+struct LinkEvent;
 
 // Packet types for PvP battle communication
 enum class PacketType {
@@ -17,6 +23,16 @@ enum class PacketType {
     LOSE,                // Sent when a player has no usable Pokemon left
     BATTLE_END,          // Sent when battle ends
     POKEMON_DATA,        // Sent to sync Pokemon data at battle start
+    RESYNC_HASH,         // PvP recovery: state summary (format: "turn,hasTurn,ownHash,enemyHash,kind")
+    RESYNC_STATE,        // PvP recovery: delta-encoded battle state (see BattleSync_BT)
+    BAUD_PROPOSE,        // Link negotiation: propose next baud rate (format: "rate,nonce")
+    BAUD_ACK,            // Link negotiation: responder accepts proposal (format: "rate")
+    BAUD_PROBE,          // Link negotiation: test packet sent at the new rate (format: "seq")
+    BAUD_RESULT,         // Link negotiation: probes received intact (format: "goodCount")
+    BAUD_CONFIRM,        // Link negotiation: initiator keeps the new rate (format: "rate")
+    BAUD_FALLBACK,       // Link negotiation: drop back to the base rate after CRC errors
+    PING,                // Link health: round-trip probe (format: "seq,sentMicros")
+    PONG,                // Link health: PING echoed back unchanged
     INVALID
 };
 
@@ -28,11 +44,42 @@ struct BattlePacket {
     BattlePacket() : type(PacketType::INVALID) {}
     BattlePacket(PacketType t, const QString& d = "") : type(t), data(d) {}
     
-    // Serialize to string for transmission
+    // Wire name of a packet type, e.g. "TURN"
+    static QString typeName(PacketType type);
+
+    // Serialize to string for transmission (appends "*CRC16" before the newline)
     QString serialize() const;
     
-    // Deserialize from string
-    static BattlePacket deserialize(const QString& str);
+    // Deserialize from string. crcOk is set to false if a CRC is present and does not match.
+    // Packets without a CRC suffix are still accepted for compatibility with older builds.
+    static BattlePacket deserialize(const QString& str, bool *crcOk = nullptr);
+
+    // True for the BAUD_* and PING/PONG packets that UartComm consumes internally
+    bool isLinkControl() const;
+};
+
+// Link health counters. Counts and bytes accumulate since initialize() or
+// the last resetLinkStats(). RTT includes the 16 ms frame pump on both ends.
+struct LinkStats {
+    QMap<QString, quint64> packetsSent;      // Keyed by BattlePacket::typeName()
+    QMap<QString, quint64> packetsReceived;
+    quint64 bytesSent = 0;
+    quint64 bytesReceived = 0;
+    quint64 crcFailures = 0;
+    quint64 parseFailures = 0;
+    quint64 retransmits = 0;                 // Packets re-sent because no reply came
+    quint64 pingsSent = 0;
+    quint64 pongsReceived = 0;
+    double lastRttMs = 0.0;
+    double minRttMs = 0.0;
+    double maxRttMs = 0.0;
+    double avgRttMs = 0.0;                   // Exponential moving average
+    int txQueueDepth = 0;                    // GUI -> I/O thread ring, current
+    int rxQueueDepth = 0;                    // I/O thread -> GUI ring, current
+    int txQueueHighWater = 0;
+    int rxQueueHighWater = 0;
+    int deferredHighWater = 0;               // Packets held back during negotiation
+    qint64 elapsedMs = 0;                    // Time covered by these numbers
 };
 
 class UartComm : public QObject
@@ -43,7 +90,8 @@ public:
     explicit UartComm(QObject *parent = nullptr);
     ~UartComm();
     
-    // Initialize UART connection
+    // Open the link. portName is a LinkTransport spec: a UART device path,
+    // "pty", "tcp:host:port" or "unix:/path".
     bool initialize(const QString& portName = "/dev/ttyS1", qint32 baudRate = 115200);
     
     // Close UART connection
@@ -53,7 +101,10 @@ public:
     bool sendPacket(const BattlePacket& packet);
     
     // Check if connected
-    bool isConnected() const { return uartFd >= 0; }
+    bool isConnected() const { return transport && linkConnected; }
+
+    // Human-readable link name for logs
+    QString getLinkDescription() const { return transport ? transport->description() : QString(); }
     
     // Check if currently finding player
     bool isFindingPlayer() const { return findingPlayer; }
@@ -62,24 +113,103 @@ public:
     void startFindingPlayer();
     void stopFindingPlayer();
 
+    // Baud rate negotiation. Both boards open the port at the base rate, then
+    // the initiator steps up the ladder (230400, 460800, 921600, ...) while the
+    // measured probe error rate stays acceptable. Other packets sent while a
+    // step is in progress are held back and flushed once the rate settles.
+    void startBaudNegotiation();
+    bool isNegotiating() const { return negotiationState != NegotiationState::Idle; }
+    void setMaxBaudRate(qint32 rate) { maxBaudRate = rate; }
+    qint32 getBaudRate() const { return currentBaudRate; }
+    qint32 getBaseBaudRate() const { return baseBaudRate; }
+
+    // Fraction of probes lost or corrupted at each rate tried (0.0 - 1.0)
+    QMap<qint32, double> getBaudErrorRates() const { return baudErrorRates; }
+
+    // Link health. Once the peer has answered, stats are also written to the
+    // log every statsLogInterval ms (0 disables the periodic dump).
+    LinkStats linkStats() const;
+    void resetLinkStats();
+    void dumpLinkStats() const;
+    void setStatsLogInterval(int ms);
+
 signals:
     void packetReceived(const BattlePacket& packet);
     void connectionStatusChanged(bool connected);
     void playerFound();  // Emitted when READY_BATTLE is received
+    void baudRateChanged(qint32 baudRate);
 
 private slots:
-    void handleReadyRead();
+    void pumpLink();  // Drain packets decoded by the I/O thread (on eventsReady)
     void sendFindingPlayerPacket();
+    void onNegotiationTimeout();
+    void sendPing();
 
 private:
-    int uartFd;  // File descriptor for UART
-    QSocketNotifier *readNotifier;  // Monitor UART for incoming data
+    enum class NegotiationState {
+        Idle,
+        Proposing,        // Initiator: waiting for BAUD_ACK
+        AwaitingResult,   // Initiator: probes sent, waiting for BAUD_RESULT
+        AwaitingProbes,   // Responder: switched rate, counting BAUD_PROBE packets
+        AwaitingConfirm   // Responder: result sent, waiting for BAUD_CONFIRM
+    };
+
+    LinkTransport *transport;  // UART, pty or socket backend
+    LinkIoThread *ioThread;    // Does all reads/writes on the transport
+    bool linkConnected;
+    bool peerActive;           // Peer has answered; PING and stats dumps run
     QTimer *findingPlayerTimer;
     bool findingPlayer;
-    QString receiveBuffer;
+
+    // Baud rate state
+    qint32 baseBaudRate = 115200;
+    qint32 currentBaudRate = 115200;
+    qint32 maxBaudRate = 3000000;
+    qint32 previousBaudRate = 115200;  // Last rate both sides agreed on
+    qint32 pendingBaudRate = 0;        // Rate currently being tested
+    NegotiationState negotiationState = NegotiationState::Idle;
+    QTimer *negotiationTimer;
+    quint32 negotiationNonce = 0;
+    int probesReceived = 0;
+    int linkErrorCount = 0;            // Consecutive CRC/parse failures at the current rate
+    QMap<qint32, double> baudErrorRates;
+    QList<BattlePacket> deferredPackets;
+
+    // Link statistics
+    LinkStats stats;
+    QElapsedTimer statsClock;   // Since the last reset
+    QElapsedTimer linkClock;    // Monotonic source for PING timestamps
+    QTimer *pingTimer;
+    QTimer *statsLogTimer;
+    quint32 pingSeq = 0;
     
-    // Parse incoming data
-    void parseReceivedData();
+    // Handle one event from the I/O thread
+    void handleLinkEvent(const LinkEvent& event);
+
+    // Queue a packet for the I/O thread, bypassing the negotiation hold-back
+    bool writePacket(const BattlePacket& packet);
+
+    // Send a packet again because the peer hasn't answered yet
+    bool resendPacket(const BattlePacket& packet);
+
+    void recordRtt(double rttMs);
+
+    // Keep-alive PINGs and periodic stats dumps only run while a peer is
+    // answering, so an idle link costs no wire traffic or wakeups
+    void startPeerTimers();
+    void stopPeerTimers();
+
+    // Ask the I/O thread to reprogram the line rate. Queued behind any
+    // pending writes, so packets already sent go out at the old rate.
+    bool applyBaudRate(qint32 baudRate);
+
+    // Negotiation steps
+    void handleLinkControlPacket(const BattlePacket& packet);
+    void proposeNextBaudRate();
+    void sendBaudProbes();
+    void finishNegotiation();
+    void handleLinkError();
+    void flushDeferredPackets();
 };
 
 #endif // UART_COMM_H
@@ -4,6 +4,10 @@
 #include "../Battle/GUI_BT.h"
 #include "../Battle/Battle_logic/PokemonData.h"
 #include "uart_comm.h"
+#include "game_loop.h"
+#include "framebuffer_renderer.h"
+#include "game_view.h"
+#include "frame_profiler.h"
 #include <QDebug>
 #include <QApplication>
 #include <QShowEvent>
@@ -22,11 +26,18 @@ Window::Window(QWidget *parent)
 
     // Create scene and view
     scene = new QGraphicsScene(0, 0, 480, 272, this);
-    view = new QGraphicsView(scene, this);
+    view = new GameView(scene, this);
     view->setFixedSize(480, 272);
     view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     view->setFocusPolicy(Qt::StrongFocus);
+    // Repaint only what changed: the player's old and new rects, plus the
+    // strip uncovered when the camera scrolls (the rest is blitted)
+    view->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+    view->setOptimizationFlags(QGraphicsView::DontSavePainterState |
+                               QGraphicsView::DontAdjustForAntialiasing);
+    view->setRenderHint(QPainter::Antialiasing, false);
+    view->setRenderHint(QPainter::SmoothPixmapTransform, false);
     // Install event filter to intercept arrow keys before QGraphicsView handles them
     view->installEventFilter(this);
 
@@ -35,9 +46,14 @@ Window::Window(QWidget *parent)
     setFocus();
     view->setFocus();
 
+#ifdef POKELITE_PROFILE
+    FrameProfiler::install();
+    profilerOverlay = new FrameProfilerOverlay(this);
+#endif
+
     // Initialize game systems
     overworld = new Overworld(scene, view);
-    battleSequence = new BattleSequence(scene, view);
+    battleSequence = new BattleSequence(view);
 
     // Connect overworld signals
     connect(overworld, &Overworld::wildEncounterTriggered, this, &Window::onWildEncounterTriggered);
@@ -50,39 +66,57 @@ Window::Window(QWidget *parent)
     uartComm = new UartComm(this);
     connect(uartComm, &UartComm::packetReceived, this, &Window::onUartPacketReceived);
     connect(uartComm, &UartComm::playerFound, this, &Window::onPlayerFound);
+    connect(uartComm, &UartComm::connectionStatusChanged, this, [this](bool connected) {
+        // Link came back mid-battle (socket peer reconnected): compare states right away
+        if (connected && inBattle && battleSequence) {
+            battleSequence->requestResync();
+        }
+    });
     
-    // Try to initialize UART (may fail if not on BeagleBone, that's okay)
-    uartComm->initialize();
+    // Try to initialize UART (may fail if not on BeagleBone, that's okay).
+    // POKELITE_LINK overrides the link for desktop testing, e.g. "pty",
+    // "/dev/pts/3", "tcp:127.0.0.1:7777" or "unix:/tmp/pokelite.sock".
+    QString linkSpec = qEnvironmentVariable("POKELITE_LINK", "/dev/ttyS1");
+    uartComm->initialize(linkSpec);
 
     // Initialize player
     initializePlayer();
 
-    // Load default map
-    overworld->loadMap("route6");
+    // Load default map (named in the map manifest)
+    overworld->loadMap(MapLoader::defaultMap());
     
     // Initialize gamepad thread (for use after intro screen)
     gamepadThread = new Gamepad("/dev/input/event1", this);
     connect(gamepadThread, &Gamepad::inputReceived, this, &Window::handleGamepadInput);
     gamepadThread->start();
     
-    // Initialize D-pad repeat timer for continuous movement
-    dpadRepeatTimer = new QTimer(this);
-    dpadRepeatTimer->setInterval(50); // ~20 times per second for smooth movement
-    connect(dpadRepeatTimer, &QTimer::timeout, this, [this]() {
-        if (currentDpadKey != Qt::Key_unknown && !inBattle && !findingPlayer && !overworld->isInMenu()) {
-            QKeyEvent *event = new QKeyEvent(QEvent::KeyPress, currentDpadKey, Qt::NoModifier);
-            QApplication::postEvent(this, event);
+    // Overworld movement runs on a fixed 60 Hz step; it samples the held
+    // keys each tick instead of reacting to (synthetic) key events
+    gameLoop = new GameLoop(this);
+    connect(gameLoop, &GameLoop::tick, this, &Window::onGameTick);
+    connect(gameLoop, &GameLoop::render, this, &Window::onGameRender);
+
+    // Optional direct framebuffer output, e.g. POKELITE_FB=/dev/fb0, or a
+    // plain file path to capture raw 480x272 XRGB frames on a desktop
+    QString fbPath = qEnvironmentVariable("POKELITE_FB");
+    if (!fbPath.isEmpty()) {
+        framebuffer = new FramebufferRenderer(view, this);
+        if (!framebuffer->open(fbPath)) {
+            delete framebuffer;
+            framebuffer = nullptr;
         }
-    });
-    
-    // Initialize keyboard movement timer for continuous movement (same as D-pad)
-    keyboardMovementTimer = new QTimer(this);
-    keyboardMovementTimer->setInterval(50); // ~20 times per second for smooth movement
-    connect(keyboardMovementTimer, &QTimer::timeout, this, &Window::processKeyboardMovement);
+    }
 }
 
 Window::~Window()
 {
+#ifdef POKELITE_PROFILE
+    const QString tracePath = qEnvironmentVariable("POKELITE_TRACE");
+    if (!tracePath.isEmpty()) {
+        FrameProfiler::exportChromeTrace(tracePath);
+    }
+#endif
+
     if (gamepadThread) {
         gamepadThread->stop();
         delete gamepadThread;
@@ -150,14 +184,14 @@ void Window::setChosenStarter(const QString& starterName)
     initializePlayer();
 }
 
-void Window::onWildEncounterTriggered()
+void Window::onWildEncounterTriggered(int dexNumber, int level)
 {
     if (inBattle) return; // Already in battle
     
-    startWildEncounter();
+    startWildEncounter(dexNumber, level);
 }
 
-void Window::startWildEncounter()
+void Window::startWildEncounter(int dexNumber, int level)
 {
     // Clean up previous enemy player if exists
     if (enemyPlayer) {
@@ -166,9 +200,8 @@ void Window::startWildEncounter()
     
     // Create enemy player (wild Pokemon)
     enemyPlayer = new Player("Wild Pokemon", PlayerType::NPC);
-    // Random wild Pokemon (for now, use random dex number)
-    int randomDex = QRandomGenerator::global()->bounded(1, 152); // 1-151
-    Pokemon wildPokemon(randomDex, 5);
+    // Species and level come from the map's encounter table
+    Pokemon wildPokemon(dexNumber, level);
     enemyPlayer->addPokemon(wildPokemon);
     
     // Initialize battle system
@@ -185,6 +218,7 @@ void Window::startWildEncounter()
     
     // Start battle sequence
     battleSequence->startBattle(gamePlayer, enemyPlayer, battleSystem);
+    if (framebuffer) framebuffer->requestFrame();
     
     inBattle = true;
 }
@@ -192,7 +226,7 @@ void Window::startWildEncounter()
 void Window::onBattleEnded()
 {
     inBattle = false;
-    
+
     // Clean up battle system and enemy player
     if (battleSystem) {
         delete battleSystem;
@@ -209,6 +243,7 @@ void Window::onBattleEnded()
     if (overworldScene) {
         view->setScene(overworldScene);
     }
+    if (framebuffer) framebuffer->requestFrame();
     view->setFixedSize(480, 272);
     
     // Re-apply overworld zoom
@@ -218,22 +253,25 @@ void Window::onBattleEnded()
     
     // Re-center camera on player
     Player_OW* playerItem = overworld->getPlayerItem();
-    if (playerItem) {
-        view->centerOn(playerItem);
-    }
-    
-    // Clean up battle scene
-    QGraphicsScene* bs = battleSequence->getScene();
-    if (bs && bs != overworldScene) {
-        delete bs;
+    if (playerItem && overworld->getCamera()) {
+        overworld->getCamera()->updateCamera(playerItem);
     }
-    
+
+    // battleSequence keeps its scene for the next battle
     setFocus();
     view->setFocus();
 }
 
 void Window::keyPressEvent(QKeyEvent *event)
 {
+#ifdef POKELITE_PROFILE
+    if (event->key() == Qt::Key_F3) {
+        profilerOverlay->toggle();
+        return;
+    }
+#endif
+    PROFILE_ZONE("window.key");
+
     // Handle Escape/B to cancel finding player
     if (findingPlayer && (event->key() == Qt::Key_Escape || event->key() == Qt::Key_B)) {
         findingPlayer = false;
@@ -271,15 +309,14 @@ void Window::keyPressEvent(QKeyEvent *event)
     }
     
     // Handle overworld movement (only WASD, ignore arrow keys to prevent camera movement)
-    // Use timer-based movement for consistent speed across platforms
+    // The game loop moves the player while the key is held
     if (event->key() == Qt::Key_W || event->key() == Qt::Key_A || 
         event->key() == Qt::Key_S || event->key() == Qt::Key_D) {
-        // Ignore auto-repeat events - we handle continuous movement via timer
+        // Ignore auto-repeat events - held state is all we need
         if (!event->isAutoRepeat()) {
-            startKeyboardMovement(static_cast<Qt::Key>(event->key()));
+            pressedMovementKeys.insert(static_cast<Qt::Key>(event->key()));
+            gameLoop->start();
         }
-        // Check for lab entrance after movement
-        checkLabEntrance();
     }
     // Explicitly accept arrow keys to prevent QGraphicsView from scrolling the camera
     else if (event->key() == Qt::Key_Up || event->key() == Qt::Key_Down || 
@@ -294,14 +331,11 @@ void Window::keyReleaseEvent(QKeyEvent *event)
     if (event->isAutoRepeat())
         return;
 
-    // Handle keyboard movement key releases
+    // Handle keyboard movement key releases; the next tick stops the
+    // walking animation once nothing is held
     if (event->key() == Qt::Key_W || event->key() == Qt::Key_A || 
         event->key() == Qt::Key_S || event->key() == Qt::Key_D) {
-        stopKeyboardMovement(static_cast<Qt::Key>(event->key()));
-    }
-
-    if (!inBattle) {
-        overworld->handleKeyRelease(event);
+        pressedMovementKeys.remove(static_cast<Qt::Key>(event->key()));
     }
 }
 
@@ -314,6 +348,15 @@ void Window::showEvent(QShowEvent *event)
         view->setFocus();
         activateWindow();
     });
+
+    gameLoop->start();
+}
+
+void Window::hideEvent(QHideEvent *event)
+{
+    QMainWindow::hideEvent(event);
+    // Nothing to simulate while the lab or intro screens are up
+    gameLoop->stop();
 }
 
 bool Window::eventFilter(QObject *obj, QEvent *event)
@@ -342,6 +385,18 @@ bool Window::eventFilter(QObject *obj, QEvent *event)
 
 void Window::handleGamepadInput(int type, int code, int value)
 {
+    PROFILE_INPUT();
+
+#ifdef POKELITE_PROFILE
+    // START+SELECT toggles the profiler overlay; SELECT does nothing else then
+    if (type == 1 && code == 315) {
+        startButtonHeld = (value != 0);
+    } else if (type == 1 && code == 314 && value == 1 && startButtonHeld) {
+        profilerOverlay->toggle();
+        return;
+    }
+#endif
+
     // Linux input event types
     // EV_KEY = 1 (button events)
     // EV_ABS = 3 (analog stick/dpad events)
@@ -381,7 +436,9 @@ void Window::handleGamepadInput(int type, int code, int value)
                 simulateKeyRelease(Qt::Key_Escape);
             }
         } else if (code == 314) { // SELECT button
-            if (pressed && !inBattle && !findingPlayer) {
+            if (pressed && inBattle) {
+                simulateKeyPress(Qt::Key_Select);  // Battle speed
+            } else if (pressed && !findingPlayer) {
                 onPvpBattleRequested();
             }
         } else if (code == 315) { // START button
@@ -394,150 +451,99 @@ void Window::handleGamepadInput(int type, int code, int value)
         // ABS_Y = 1 (left stick Y or dpad up/down)
         // ABS_HAT0X = 16 (dpad X)
         // ABS_HAT0Y = 17 (dpad Y)
-        
-        // Prioritize D-pad over analog stick
+        //
+        // Only the held direction is recorded here; the game loop reads it
+        // every tick. Menus and battle still get one key press per new direction.
         if (code == 16) { // D-pad X
-            // Stop analog stick if D-pad is being used
-            if (value != 0) {
-                // D-pad is pressed - stop analog stick
-                simulateKeyRelease(Qt::Key_A);
-                simulateKeyRelease(Qt::Key_D);
-            }
-            
-            if (value == -1) { // Left
-                stopDpadRepeat();
-                startDpadRepeat(Qt::Key_A);
-            } else if (value == 1) { // Right
-                stopDpadRepeat();
-                startDpadRepeat(Qt::Key_D);
-            } else { // Released (value == 0)
-                stopDpadRepeat();
-            }
+            setHeldAxisKey(dpadKeyX, value < 0 ? Qt::Key_A : value > 0 ? Qt::Key_D : Qt::Key_unknown);
         } else if (code == 17) { // D-pad Y
-            // Stop analog stick if D-pad is being used
-            if (value != 0) {
-                // D-pad is pressed - stop analog stick
-                simulateKeyRelease(Qt::Key_W);
-                simulateKeyRelease(Qt::Key_S);
-            }
-            
-            if (value == -1) { // Up
-                stopDpadRepeat();
-                startDpadRepeat(Qt::Key_W);
-            } else if (value == 1) { // Down
-                stopDpadRepeat();
-                startDpadRepeat(Qt::Key_S);
-            } else { // Released (value == 0)
-                stopDpadRepeat();
-            }
-        } else if (code == 0) { // Left stick X - only use if D-pad not active
-            // Only process analog stick if D-pad is not currently being used
-            if (currentDpadKey == Qt::Key_unknown || (currentDpadKey != Qt::Key_A && currentDpadKey != Qt::Key_D)) {
-                if (value < -10000) { // Left threshold
-                    simulateKeyPress(Qt::Key_A);
-                } else if (value > 10000) { // Right threshold
-                    simulateKeyPress(Qt::Key_D);
-                } else { // Center
-                    simulateKeyRelease(Qt::Key_A);
-                    simulateKeyRelease(Qt::Key_D);
-                }
-            }
-        } else if (code == 1) { // Left stick Y - only use if D-pad not active
-            // Only process analog stick if D-pad is not currently being used
-            if (currentDpadKey == Qt::Key_unknown || (currentDpadKey != Qt::Key_W && currentDpadKey != Qt::Key_S)) {
-                if (value < -10000) { // Up threshold
-                    simulateKeyPress(Qt::Key_W);
-                } else if (value > 10000) { // Down threshold
-                    simulateKeyPress(Qt::Key_S);
-                } else { // Center
-                    simulateKeyRelease(Qt::Key_W);
-                    simulateKeyRelease(Qt::Key_S);
-                }
-            }
+            setHeldAxisKey(dpadKeyY, value < 0 ? Qt::Key_W : value > 0 ? Qt::Key_S : Qt::Key_unknown);
+        } else if (code == 0) { // Left stick X
+            setHeldAxisKey(stickKeyX, value < -10000 ? Qt::Key_A : value > 10000 ? Qt::Key_D : Qt::Key_unknown);
+        } else if (code == 1) { // Left stick Y
+            setHeldAxisKey(stickKeyY, value < -10000 ? Qt::Key_W : value > 10000 ? Qt::Key_S : Qt::Key_unknown);
         }
     }
 }
 
-void Window::simulateKeyPress(Qt::Key key)
+void Window::setHeldAxisKey(Qt::Key &held, Qt::Key key)
 {
-    QKeyEvent *event = new QKeyEvent(QEvent::KeyPress, key, Qt::NoModifier);
-    QApplication::postEvent(this, event);
-}
+    if (key == held) return;
+    held = key;
 
-void Window::simulateKeyRelease(Qt::Key key)
-{
-    QKeyEvent *event = new QKeyEvent(QEvent::KeyRelease, key, Qt::NoModifier);
-    QApplication::postEvent(this, event);
+    if (key != Qt::Key_unknown) {
+        gameLoop->start();
+    }
+
+    // Menu and battle navigation still works on key presses
+    if (key != Qt::Key_unknown && (inBattle || overworld->isInMenu())) {
+        simulateKeyPress(key);
+    }
 }
 
-void Window::startDpadRepeat(Qt::Key key)
+void Window::heldDirection(int *dx, int *dy) const
 {
-    // Stop any existing repeat
-    stopDpadRepeat();
-    
-    // Set the current key and send initial press
-    currentDpadKey = key;
-    simulateKeyPress(key);
-    
-    // Start timer to repeat the key press
-    dpadRepeatTimer->start();
+    const Qt::Key axisX = dpadKeyX != Qt::Key_unknown ? dpadKeyX : stickKeyX;
+    const Qt::Key axisY = dpadKeyY != Qt::Key_unknown ? dpadKeyY : stickKeyY;
+
+    *dx = 0;
+    *dy = 0;
+    if (pressedMovementKeys.contains(Qt::Key_A) || axisX == Qt::Key_A) *dx -= 1;
+    if (pressedMovementKeys.contains(Qt::Key_D) || axisX == Qt::Key_D) *dx += 1;
+    if (pressedMovementKeys.contains(Qt::Key_W) || axisY == Qt::Key_W) *dy -= 1;
+    if (pressedMovementKeys.contains(Qt::Key_S) || axisY == Qt::Key_S) *dy += 1;
 }
 
-void Window::stopDpadRepeat()
+void Window::onGameTick(qreal dt)
 {
-    if (dpadRepeatTimer) {
-        dpadRepeatTimer->stop();
+    PROFILE_ZONE("overworld.tick");
+    if (!overworld) return;
+
+    // Only move while the overworld has control
+    if (inBattle || findingPlayer || overworld->isInMenu()) {
+        overworld->stopMovement();
+        // Keep ticking only while a direction is held, so it resumes afterwards
+        int dx, dy;
+        heldDirection(&dx, &dy);
+        if (dx == 0 && dy == 0) {
+            gameLoop->stop();
+        }
+        return;
     }
-    
-    // Send key release for the current key
-    if (currentDpadKey != Qt::Key_unknown) {
-        simulateKeyRelease(currentDpadKey);
-        currentDpadKey = Qt::Key_unknown;
+
+    int dx, dy;
+    heldDirection(&dx, &dy);
+    overworld->stepMovement(dx, dy, dt);
+
+    if (dx != 0 || dy != 0) {
+        checkLabEntrance();
+        return;
     }
+
+    // Nothing held: draw the final position and sleep until the next input,
+    // so standing still costs no timer wakeups or repaints
+    overworld->renderInterpolated(1.0);
+    gameLoop->stop();
 }
 
-void Window::startKeyboardMovement(Qt::Key key)
+void Window::onGameRender(qreal alpha)
 {
-    // Add key to pressed keys set
-    pressedMovementKeys.insert(key);
-    
-    // Send initial movement event
-    QKeyEvent *event = new QKeyEvent(QEvent::KeyPress, key, Qt::NoModifier);
-    overworld->handleMovementInput(event);
-    
-    // Start timer if not already running
-    if (keyboardMovementTimer && !keyboardMovementTimer->isActive()) {
-        keyboardMovementTimer->start();
+    // The view shows the battle scene during battles
+    if (!inBattle && overworld) {
+        overworld->renderInterpolated(alpha);
     }
 }
 
-void Window::stopKeyboardMovement(Qt::Key key)
+void Window::simulateKeyPress(Qt::Key key)
 {
-    // Remove key from pressed keys set
-    pressedMovementKeys.remove(key);
-    
-    // Stop timer if no keys are pressed
-    if (keyboardMovementTimer && pressedMovementKeys.isEmpty()) {
-        keyboardMovementTimer->stop();
-        // Only send key release event when ALL movement keys are released
-        // This ensures animation continues during diagonal movement
-        QKeyEvent *event = new QKeyEvent(QEvent::KeyRelease, key, Qt::NoModifier);
-        overworld->handleKeyRelease(event);
-    }
+    QKeyEvent *event = new QKeyEvent(QEvent::KeyPress, key, Qt::NoModifier);
+    QApplication::postEvent(this, event);
 }
 
-void Window::processKeyboardMovement()
+void Window::simulateKeyRelease(Qt::Key key)
 {
-    // Only process if not in battle, not finding player, and not in menu
-    if (inBattle || findingPlayer || !overworld || overworld->isInMenu()) {
-        return;
-    }
-    
-    // Process each pressed movement key
-    for (Qt::Key key : pressedMovementKeys) {
-        QKeyEvent *event = new QKeyEvent(QEvent::KeyPress, key, Qt::NoModifier);
-        overworld->handleMovementInput(event);
-    }
+    QKeyEvent *event = new QKeyEvent(QEvent::KeyRelease, key, Qt::NoModifier);
+    QApplication::postEvent(this, event);
 }
 
 void Window::onPvpBattleRequested()
@@ -557,7 +563,13 @@ void Window::onPvpBattleRequested()
 
 void Window::onUartPacketReceived(const BattlePacket& packet)
 {
+    PROFILE_ZONE("uart.packet");
     qDebug() << "Received UART packet type:" << static_cast<int>(packet.type) << "data:" << packet.data;
+
+    // Any traffic proves the opponent is still there; keeps the resync watchdog quiet
+    if (battleSequence && inBattle) {
+        battleSequence->noteOpponentActivity();
+    }
     
     switch (packet.type) {
         case PacketType::FINDING_PLAYER:
@@ -694,6 +706,16 @@ void Window::onUartPacketReceived(const BattlePacket& packet)
         case PacketType::BATTLE_END:
             // Handle battle end from opponent
             break;
+        case PacketType::RESYNC_HASH:
+            if (battleSequence && inBattle) {
+                battleSequence->onResyncHash(packet.data);
+            }
+            break;
+        case PacketType::RESYNC_STATE:
+            if (battleSequence && inBattle) {
+                battleSequence->onResyncState(packet.data);
+            }
+            break;
         default:
             break;
     }
@@ -725,6 +747,9 @@ void Window::onPlayerFound()
     
     // Start PvP battle
     startPvpBattle();
+
+    // Step the link up to a faster baud rate; packets sent meanwhile are queued
+    uartComm->startBaudNegotiation();
 }
 
 void Window::showFindingPlayerPopup()
@@ -749,6 +774,7 @@ void Window::showFindingPlayerPopup()
     findingPlayerRect->setBrush(QColor(240, 240, 240));
     findingPlayerRect->setPen(QPen(Qt::black, 3));
     findingPlayerRect->setZValue(20);
+    GameView::markOverlay(findingPlayerRect);
     overworldScene->addItem(findingPlayerRect);
     
     // Create text
@@ -757,6 +783,7 @@ void Window::showFindingPlayerPopup()
     findingPlayerText->setDefaultTextColor(Qt::black);
     findingPlayerText->setPos(boxX + 15, boxY + 12);
     findingPlayerText->setZValue(21);
+    GameView::markOverlay(findingPlayerText);
     overworldScene->addItem(findingPlayerText);
 }
 
@@ -802,11 +829,16 @@ void Window::startPvpBattle()
     Pokemon enemyPokemon(dexNumber, level);
     enemyPlayer->addPokemon(enemyPokemon);
     
-    // Auto-heal all Pokemon in the team before battle (assume both players start at full health)
+    // Auto-heal all Pokemon in the team before battle (assume both players start at full health).
+    // PP is restored too so our team matches the opponent's freshly built mirror of it,
+    // which the resync hashes rely on.
     if (gamePlayer) {
         auto& team = gamePlayer->getTeam();
         for (auto& pokemon : team) {
             pokemon.heal(pokemon.getMaxHP());
+            for (auto& move : pokemon.getMoves()) {
+                move.restorePP(move.getMaxPP());
+            }
         }
     }
     
@@ -826,6 +858,7 @@ void Window::startPvpBattle()
     // Start battle sequence
     battleSequence->startBattle(gamePlayer, enemyPlayer, battleSystem);
     battleSequence->setUartComm(uartComm);  // Pass UART to battle sequence
+    if (framebuffer) framebuffer->requestFrame();
     
     inBattle = true;
     
@@ -885,25 +918,26 @@ void Window::checkLabEntrance()
 
     // Check if player is at lab entrance position (303, 199) with some tolerance
     if (qAbs(playerPos.x() - 303) < 10 && qAbs(playerPos.y() - 199) < 10) {
+        // Drop held input so we don't keep walking (and re-triggering) during the fade
+        clearMovementState();
         emit returnToLab();
     }
 }
 
 void Window::clearMovementState()
 {
-    // Clear all pressed movement keys
+    // Forget all held movement input
     pressedMovementKeys.clear();
-
-    // Stop keyboard movement timer
-    if (keyboardMovementTimer && keyboardMovementTimer->isActive()) {
-        keyboardMovementTimer->stop();
-    }
-
-    // Stop D-pad repeat
-    stopDpadRepeat();
+    dpadKeyX = Qt::Key_unknown;
+    dpadKeyY = Qt::Key_unknown;
+    stickKeyX = Qt::Key_unknown;
+    stickKeyY = Qt::Key_unknown;
 
     // Stop player animation in overworld
-    if (overworld && overworld->getPlayerItem()) {
-        overworld->getPlayerItem()->stopAnimation();
+    if (overworld) {
+        overworld->stopMovement();
+        if (overworld->getPlayerItem()) {
+            overworld->getPlayerItem()->stopAnimation();
+        }
     }
 }
@@ -6,6 +6,8 @@
 #include <QGraphicsScene>
 #include <QKeyEvent>
 #include <QShowEvent>
+#include <QHideEvent>
+#include <QSet>
 #include "gamepad.h"
 #include "uart_comm.h"
 #include "../Battle/BattleState_BT.h"
@@ -19,6 +21,10 @@
 // Forward declarations
 class Overworld;
 class BattleSequence;
+class GameLoop;
+class FramebufferRenderer;
+class GameView;
+class FrameProfilerOverlay;
 
 class Window : public QMainWindow
 {
@@ -38,27 +44,32 @@ protected:
     void keyPressEvent(QKeyEvent *event) override;
     void keyReleaseEvent(QKeyEvent *event) override;
     void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
     bool eventFilter(QObject *obj, QEvent *event) override;
 
 private slots:
-    void onWildEncounterTriggered();
+    void onWildEncounterTriggered(int dexNumber, int level);
     void onBattleEnded();
     void onPvpBattleRequested();
     void onUartPacketReceived(const BattlePacket& packet);
     void onPlayerFound();
+    void onGameTick(qreal dt);
+    void onGameRender(qreal alpha);
 
 private:
     // ============================================================
     // CORE QT WINDOW MANAGEMENT
     // ============================================================
     QGraphicsScene *scene = nullptr;
-    QGraphicsView  *view  = nullptr;
+    GameView       *view  = nullptr;
 
     // ============================================================
     // GAME SYSTEMS
     // ============================================================
     Overworld *overworld = nullptr;
     BattleSequence *battleSequence = nullptr;
+    GameLoop *gameLoop = nullptr;
+    FramebufferRenderer *framebuffer = nullptr;  // Only when POKELITE_FB is set
     QString chosenStarterName;
     // ============================================================
     // GAME STATE
@@ -76,18 +87,16 @@ private:
     void simulateKeyPress(Qt::Key key);
     void simulateKeyRelease(Qt::Key key);
     
-    // D-pad state tracking for continuous movement
-    QTimer *dpadRepeatTimer = nullptr;
-    Qt::Key currentDpadKey = Qt::Key_unknown;
-    void startDpadRepeat(Qt::Key key);
-    void stopDpadRepeat();
-    
-    // Keyboard movement state tracking for continuous movement
-    QTimer *keyboardMovementTimer = nullptr;
+    // Held movement input, sampled by the game loop every tick. Keyboard
+    // keys are tracked as a set; the D-pad and stick hold one key per axis
+    // (Key_unknown when centred), and the D-pad wins over the stick.
     QSet<Qt::Key> pressedMovementKeys;
-    void startKeyboardMovement(Qt::Key key);
-    void stopKeyboardMovement(Qt::Key key);
-    void processKeyboardMovement();
+    Qt::Key dpadKeyX = Qt::Key_unknown;
+    Qt::Key dpadKeyY = Qt::Key_unknown;
+    Qt::Key stickKeyX = Qt::Key_unknown;
+    Qt::Key stickKeyY = Qt::Key_unknown;
+    void setHeldAxisKey(Qt::Key &held, Qt::Key key);
+    void heldDirection(int *dx, int *dy) const;
 
     // ============================================================
     // UART COMMUNICATION
@@ -101,7 +110,7 @@ private:
     // HELPER FUNCTIONS
     // ============================================================
     void initializePlayer();
-    void startWildEncounter();
+    void startWildEncounter(int dexNumber, int level);
     void checkLabEntrance();
     
     // ============================================================
@@ -115,6 +124,14 @@ private:
     int pvpOpponentLevel = -1;
     QGraphicsRectItem *findingPlayerRect = nullptr;
     QGraphicsTextItem *findingPlayerText = nullptr;
+
+#ifdef POKELITE_PROFILE
+    // ============================================================
+    // PROFILING (debug / CONFIG+=profile builds)
+    // ============================================================
+    FrameProfilerOverlay *profilerOverlay = nullptr;
+    bool startButtonHeld = false;  // START+SELECT toggles the overlay
+#endif
 };
 
 #endif // WINDOW_H
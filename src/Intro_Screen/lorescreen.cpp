@@ -26,18 +26,16 @@ LoreScreen::LoreScreen(QWidget *parent)
     bgLabel->setPixmap(QPixmap(":/assets/intro/title/IntroBG.png"));
     bgLabel->setScaledContents(true);
 
-    loreTextLabel = new QLabel(this);
-    loreTextLabel->setGeometry(20, 80, 440, 120);
-    loreTextLabel->setWordWrap(true);
-    loreTextLabel->setAlignment(Qt::AlignCenter);
-
     QFont font;
     font.setFamily("Courier");
     font.setPointSize(11);
     font.setStyleHint(QFont::TypeWriter);
     font.setBold(true);
-    loreTextLabel->setFont(font);
-    loreTextLabel->setStyleSheet("color: black; background: transparent;");
+
+    loreTextLabel = new GlyphLabel(font, Qt::black, this);
+    loreTextLabel->setGeometry(20, 80, 440, 120);
+    loreTextLabel->setWordWrap(true);
+    loreTextLabel->setAlignment(Qt::AlignCenter);
 
     promptLabel = new QLabel(this);
     promptLabel->setGeometry(20, 220, 440, 30);
@@ -77,21 +75,20 @@ LoreScreen::~LoreScreen()
 void LoreScreen::startTyping(const QString &text)
 {
     currentFullText = text;
-    currentDisplayText = "";
     typeIndex = 0;
     isTyping = true;
     promptLabel->hide();
     glowTimer.stop();
-    loreTextLabel->setText("");
+    loreTextLabel->setText(text);  // Laid out once; typing only reveals it
+    loreTextLabel->setVisibleCount(0);
     typeTimer.start(30);
 }
 
 void LoreScreen::typeNextCharacter()
 {
     if (typeIndex < currentFullText.length()) {
-        currentDisplayText += currentFullText[typeIndex];
-        loreTextLabel->setText(currentDisplayText);
         typeIndex++;
+        loreTextLabel->setVisibleCount(typeIndex);
     } else {
         typeTimer.stop();
         isTyping = false;
@@ -134,7 +131,7 @@ void LoreScreen::keyPressEvent(QKeyEvent *event)
 
         if (isTyping) {
             typeTimer.stop();
-            loreTextLabel->setText(currentFullText);
+            loreTextLabel->setVisibleCount(currentFullText.length());
             isTyping = false;
             promptLabel->show();
             glowIntensity = 0.0f;
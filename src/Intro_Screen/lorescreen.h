@@ -7,6 +7,7 @@
 #include <QStringList>
 #include <QTimer>
 #include "../General/gamepad.h"
+#include "../General/glyph_text.h"
 
 class LoreScreen : public QWidget
 {
@@ -32,7 +33,7 @@ private:
     void startTyping(const QString &text);
     void simulateKeyPress(Qt::Key key);
 
-    QLabel *loreTextLabel;
+    GlyphLabel *loreTextLabel;
     QLabel *promptLabel;
     QLabel *bgLabel;
     QStringList loreParts;
@@ -41,7 +42,6 @@ private:
     QTimer typeTimer;
     QTimer glowTimer;
     QString currentFullText;
-    QString currentDisplayText;
     int typeIndex;
     bool isTyping;
     float glowIntensity;
@@ -1,4 +1,5 @@
 #include "Camera_OW.h"
+#include "../General/game_view.h"
 #include <QTransform>
 #include <QDebug>
 
@@ -22,6 +23,12 @@ void Camera_OW::setupZoom()
     if (view) {
         // Zoom in closer to the player
         view->setTransform(QTransform::fromScale(zoomFactor, zoomFactor));
+        hasCenter = false;
+
+        // Paint at 1x and upscale once instead of scaling every pixmap
+        if (GameView *gameView = qobject_cast<GameView *>(view)) {
+            gameView->setPixelZoom(qRound(zoomFactor));
+        }
     }
 }
 
@@ -30,6 +37,11 @@ void Camera_OW::removeZoom()
     if (view) {
         // Reset to no zoom (1:1 scale)
         view->resetTransform();
+        hasCenter = false;
+
+        if (GameView *gameView = qobject_cast<GameView *>(view)) {
+            gameView->setPixelZoom(1);
+        }
     }
 }
 
@@ -67,6 +79,22 @@ void Camera_OW::updateCamera(QGraphicsItem *player)
     if (targetY < minCY) targetY = minCY;
     if (targetY > maxCY) targetY = maxCY;
 
-    view->centerOn(targetX, targetY);
+    // Snap to whole map pixels so scrolling is an exact blit (and the 1x
+    // GameView buffer never resamples), and don't touch the view at all if
+    // the camera hasn't moved
+    targetX = qRound(targetX);
+    targetY = qRound(targetY);
+    QPointF center(targetX, targetY);
+    if (hasCenter && center == lastCenter && view->scene() == lastScene) return;
+
+    view->centerOn(center);
+    lastCenter = center;
+    lastScene = view->scene();
+    hasCenter = true;
 }
 
+QRectF Camera_OW::visibleSceneRect() const
+{
+    if (!view) return QRectF();
+    return view->mapToScene(view->viewport()->rect()).boundingRect();
+}
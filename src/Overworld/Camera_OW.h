@@ -15,8 +15,16 @@ public:
     void setupZoom();
     void removeZoom();
 
+    // Scene area currently shown by the view
+    QRectF visibleSceneRect() const;
+
 private:
     QGraphicsView *view;
+
+    // Last centre handed to the view; centerOn() is skipped when unchanged
+    QPointF lastCenter;
+    QGraphicsScene *lastScene = nullptr;
+    bool hasCenter = false;
     const qreal viewW = 480;
     const qreal viewH = 272;
     const qreal zoomFactor = 2.0;  // Zoom level (2.0 = 2x zoom)
@@ -0,0 +1,148 @@
+#include "Collision_OW.h"
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COLLISION_OW_NEON 1
+#endif
+
+void Collision_OW::build(const quint8 *attributes, int width, int height, quint8 solidBit)
+{
+    clear();
+    if (!attributes || width <= 0 || height <= 0) return;
+
+    w = width;
+    h = height;
+    wordsPerRow = (width + 63) / 64;
+    bits.fill(0, wordsPerRow * height);
+
+    for (int y = 0; y < height; ++y) {
+        const quint8 *src = attributes + y * width;
+        quint64 *row = bits.data() + y * wordsPerRow;
+        for (int x = 0; x < width; ++x) {
+            if (src[x] & solidBit) {
+                row[x >> 6] |= quint64(1) << (x & 63);
+            }
+        }
+    }
+}
+
+void Collision_OW::clear()
+{
+    w = 0;
+    h = 0;
+    wordsPerRow = 0;
+    bits.clear();
+}
+
+bool Collision_OW::isSolid(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= w || y >= h) return true;
+    return (bits[y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+}
+
+bool Collision_OW::rowSpanHitsSolid(int y, int x0, int x1) const
+{
+    const quint64 *row = bits.constData() + y * wordsPerRow;
+    const int w0 = x0 >> 6;
+    const int w1 = x1 >> 6;
+    const quint64 firstMask = ~quint64(0) << (x0 & 63);
+    const quint64 lastMask = ~quint64(0) >> (63 - (x1 & 63));
+
+    if (w0 == w1) {
+        return row[w0] & firstMask & lastMask;
+    }
+    if ((row[w0] & firstMask) || (row[w1] & lastMask)) {
+        return true;
+    }
+
+    // Whole words in between (only for wide spans)
+    int i = w0 + 1;
+#ifdef COLLISION_OW_NEON
+    uint64x2_t acc = vdupq_n_u64(0);
+    for (; i + 1 < w1; i += 2) {
+        acc = vorrq_u64(acc, vld1q_u64(reinterpret_cast<const uint64_t *>(row + i)));
+    }
+    if (vgetq_lane_u64(acc, 0) | vgetq_lane_u64(acc, 1)) {
+        return true;
+    }
+#endif
+    for (; i < w1; ++i) {
+        if (row[i]) return true;
+    }
+    return false;
+}
+
+bool Collision_OW::rectHitsSolid(int x0, int y0, int x1, int y1) const
+{
+    if (x0 > x1 || y0 > y1) return false;
+    if (x0 < 0 || y0 < 0 || x1 >= w || y1 >= h) return true;
+
+    for (int y = y0; y <= y1; ++y) {
+        if (rowSpanHitsSolid(y, x0, x1)) return true;
+    }
+    return false;
+}
+
+qreal Collision_OW::sweepX(const QRectF &foot, qreal dx) const
+{
+    if (dx == 0.0) return 0.0;
+
+    const int y0 = static_cast<int>(std::floor(foot.top()));
+    const int y1 = static_cast<int>(std::ceil(foot.bottom())) - 1;
+
+    if (dx > 0) {
+        // Columns newly covered by the leading (right) edge
+        const int first = static_cast<int>(std::ceil(foot.right()));
+        const int last = static_cast<int>(std::ceil(foot.right() + dx)) - 1;
+        for (int c = first; c <= last; ++c) {
+            if (rectHitsSolid(c, y0, c, y1)) {
+                return c - foot.right();
+            }
+        }
+    } else {
+        const int first = static_cast<int>(std::floor(foot.left())) - 1;
+        const int last = static_cast<int>(std::floor(foot.left() + dx));
+        for (int c = first; c >= last; --c) {
+            if (rectHitsSolid(c, y0, c, y1)) {
+                return (c + 1) - foot.left();
+            }
+        }
+    }
+    return dx;
+}
+
+qreal Collision_OW::sweepY(const QRectF &foot, qreal dy) const
+{
+    if (dy == 0.0) return 0.0;
+
+    const int x0 = static_cast<int>(std::floor(foot.left()));
+    const int x1 = static_cast<int>(std::ceil(foot.right())) - 1;
+
+    if (dy > 0) {
+        // Rows newly covered by the leading (bottom) edge
+        const int first = static_cast<int>(std::ceil(foot.bottom()));
+        const int last = static_cast<int>(std::ceil(foot.bottom() + dy)) - 1;
+        for (int r = first; r <= last; ++r) {
+            if (rectHitsSolid(x0, r, x1, r)) {
+                return r - foot.bottom();
+            }
+        }
+    } else {
+        const int first = static_cast<int>(std::floor(foot.top())) - 1;
+        const int last = static_cast<int>(std::floor(foot.top() + dy));
+        for (int r = first; r >= last; --r) {
+            if (rectHitsSolid(x0, r, x1, r)) {
+                return (r + 1) - foot.top();
+            }
+        }
+    }
+    return dy;
+}
+
+QPointF Collision_OW::sweep(const QRectF &foot, const QPointF &delta) const
+{
+    const qreal dx = sweepX(foot, delta.x());
+    const qreal dy = sweepY(foot.translated(dx, 0), delta.y());
+    return QPointF(dx, dy);
+}
@@ -0,0 +1,46 @@
+#ifndef COLLISION_OW_H
+#define COLLISION_OW_H
+
+#include <QVector>
+#include <QRectF>
+#include <QPointF>
+
+// 1-bit-per-pixel solid map built from Map_OW's attribute grid. Rows are
+// padded to whole 64-bit words so a span of pixels is tested with a few
+// masked word ORs (NEON on the BeagleBone) instead of one lookup per pixel.
+class Collision_OW
+{
+public:
+    Collision_OW() {}
+
+    // Set bit for every attribute byte with solidBit set
+    void build(const quint8 *attributes, int width, int height, quint8 solidBit);
+    void clear();
+
+    int width() const { return w; }
+    int height() const { return h; }
+
+    // Outside the bitmap counts as solid
+    bool isSolid(int x, int y) const;
+
+    // True if any pixel of the inclusive rectangle is solid
+    bool rectHitsSolid(int x0, int y0, int x1, int y1) const;
+
+    // Move the foot rectangle by delta, x axis first then y, stopping flush
+    // against the first solid pixel on each axis. Returns the delta actually
+    // allowed. Every pixel the rectangle sweeps over is tested, so fast
+    // movement can't skip through thin walls.
+    QPointF sweep(const QRectF &foot, const QPointF &delta) const;
+
+private:
+    int w = 0;
+    int h = 0;
+    int wordsPerRow = 0;
+    QVector<quint64> bits;
+
+    bool rowSpanHitsSolid(int y, int x0, int x1) const;
+    qreal sweepX(const QRectF &foot, qreal dx) const;
+    qreal sweepY(const QRectF &foot, qreal dy) const;
+};
+
+#endif // COLLISION_OW_H
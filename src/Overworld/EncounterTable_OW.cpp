@@ -0,0 +1,59 @@
+#include "EncounterTable_OW.h"
+
+void EncounterTable_OW::build(const QVector<EncounterSlot> &rows)
+{
+    slots.clear();
+    for (const EncounterSlot &row : rows) {
+        if (row.weight > 0) slots.append(row);
+    }
+
+    const int n = slots.size();
+    keepChance.fill(1.0, n);
+    alias.resize(n);
+    if (n == 0) return;
+
+    double total = 0;
+    for (const EncounterSlot &row : slots) total += row.weight;
+
+    // Scale weights so the average column holds exactly 1.0
+    QVector<double> scaled(n);
+    QVector<int> small, large;
+    for (int i = 0; i < n; ++i) {
+        alias[i] = i;
+        scaled[i] = slots[i].weight * n / total;
+        if (scaled[i] < 1.0)
+            small.append(i);
+        else
+            large.append(i);
+    }
+
+    // Fill each under-full column with the remainder of an over-full one
+    while (!small.isEmpty() && !large.isEmpty()) {
+        const int s = small.takeLast();
+        const int l = large.takeLast();
+        keepChance[s] = scaled[s];
+        alias[s] = l;
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if (scaled[l] < 1.0)
+            small.append(l);
+        else
+            large.append(l);
+    }
+
+    // Whatever is left is 1.0 up to rounding error
+    for (int i : large) keepChance[i] = 1.0;
+    for (int i : small) keepChance[i] = 1.0;
+}
+
+void EncounterTable_OW::sample(QRandomGenerator *rng, int *dexNumber, int *level) const
+{
+    if (slots.isEmpty()) return;
+
+    int column = rng->bounded(slots.size());
+    if (rng->generateDouble() >= keepChance[column])
+        column = alias[column];
+
+    const EncounterSlot &slot = slots[column];
+    *dexNumber = slot.dexNumber;
+    *level = rng->bounded(slot.minLevel, slot.maxLevel + 1);
+}
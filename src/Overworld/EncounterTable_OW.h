@@ -0,0 +1,29 @@
+#ifndef ENCOUNTERTABLE_OW_H
+#define ENCOUNTERTABLE_OW_H
+
+#include <QVector>
+#include <QRandomGenerator>
+#include "map_loader.h"
+
+// Weighted wild encounter table sampled with Walker's alias method (Vose's
+// construction). build() is O(n) once per map load; each sample is one
+// uniform column pick plus one biased coin, however many rows the table has.
+class EncounterTable_OW
+{
+public:
+    EncounterTable_OW() {}
+
+    void build(const QVector<EncounterSlot> &rows);
+    bool isEmpty() const { return slots.isEmpty(); }
+    int size() const { return slots.size(); }
+
+    // Pick a row and roll a level in its range
+    void sample(QRandomGenerator *rng, int *dexNumber, int *level) const;
+
+private:
+    QVector<EncounterSlot> slots;
+    QVector<double> keepChance;  // Chance column i keeps its own row
+    QVector<int> alias;          // Row used otherwise
+};
+
+#endif // ENCOUNTERTABLE_OW_H
@@ -0,0 +1,122 @@
+#include "MapStreamer_OW.h"
+#include <QRunnable>
+#include <QDebug>
+
+class PrepareMapTask : public QRunnable
+{
+public:
+    PrepareMapTask(MapStreamer_OW *streamer, const QString &name)
+        : streamer(streamer), name(name) {}
+
+    void run() override
+    {
+        QSharedPointer<const PreparedMap> map = Map_OW::prepareMap(name);
+
+        // Hand the result back on the GUI thread
+        MapStreamer_OW *target = streamer;
+        QMetaObject::invokeMethod(streamer, [target, map]() {
+            target->onPrepared(map);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    MapStreamer_OW *streamer;
+    QString name;
+};
+
+class DecodeChunkTask : public QRunnable
+{
+public:
+    DecodeChunkTask(MapStreamer_OW *streamer, const QString &chunkDir, const QString &background,
+                    int col, int row, const std::function<void(const QImage &)> &done)
+        : streamer(streamer), chunkDir(chunkDir), background(background),
+          col(col), row(row), done(done) {}
+
+    void run() override
+    {
+        const QImage image = Map_OW::readChunk(chunkDir, background, col, row);
+
+        // QPixmap can only be made on the GUI thread
+        std::function<void(const QImage &)> callback = done;
+        QMetaObject::invokeMethod(streamer, [callback, image]() {
+            callback(image);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    MapStreamer_OW *streamer;
+    QString chunkDir;
+    QString background;
+    int col;
+    int row;
+    std::function<void(const QImage &)> done;
+};
+
+MapStreamer_OW::MapStreamer_OW(QObject *parent)
+    : QObject(parent)
+{
+    pool.setMaxThreadCount(1);
+}
+
+MapStreamer_OW::~MapStreamer_OW()
+{
+    // Results queued after this point are dropped along with the object
+    pool.waitForDone();
+}
+
+void MapStreamer_OW::prefetch(const QString &name)
+{
+    if (name.isEmpty() || ready.contains(name) || inFlight.contains(name)) return;
+
+    inFlight.insert(name);
+    pool.start(new PrepareMapTask(this, name));
+}
+
+void MapStreamer_OW::decodeChunk(const QString &chunkDir, const QString &background, int col, int row,
+                                 const std::function<void(const QImage &)> &done)
+{
+    // Higher priority than map prefetches: the player is about to see it
+    pool.start(new DecodeChunkTask(this, chunkDir, background, col, row, done), 1);
+}
+
+QSharedPointer<const PreparedMap> MapStreamer_OW::take(const QString &name)
+{
+    QSharedPointer<const PreparedMap> map = ready.take(name);
+    if (map) {
+        return map;
+    }
+
+    // Not prefetched (or still decoding): load synchronously like before
+    if (inFlight.remove(name)) {
+        qDebug() << "Map" << name << "still preparing, loading synchronously";
+    }
+    return Map_OW::prepareMap(name);
+}
+
+void MapStreamer_OW::store(const QSharedPointer<const PreparedMap> &map)
+{
+    if (!map) return;
+
+    inFlight.remove(map->name);
+    ready.insert(map->name, map);
+}
+
+void MapStreamer_OW::retainOnly(const QSet<QString> &names)
+{
+    for (auto it = ready.begin(); it != ready.end(); ) {
+        if (names.contains(it.key()))
+            ++it;
+        else
+            it = ready.erase(it);
+    }
+
+    // A task still running for a dropped map is discarded when it finishes
+    inFlight.intersect(names);
+}
+
+void MapStreamer_OW::onPrepared(const QSharedPointer<const PreparedMap> &map)
+{
+    if (!inFlight.remove(map->name)) return;  // No longer wanted
+
+    ready.insert(map->name, map);
+}
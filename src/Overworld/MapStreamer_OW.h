@@ -0,0 +1,54 @@
+#ifndef MAPSTREAMER_OW_H
+#define MAPSTREAMER_OW_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <functional>
+#include "Map_OW.h"
+
+// Prepares neighbouring maps on a background thread so walking through an
+// exit is a swap instead of a decode. Overworld asks for a prefetch when the
+// player gets close to an exit; take() hands back the prepared map, or builds
+// it on the spot if the prefetch hasn't finished.
+class MapStreamer_OW : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MapStreamer_OW(QObject *parent = nullptr);
+    ~MapStreamer_OW();
+
+    // Start preparing a map unless it is ready or already being prepared
+    void prefetch(const QString &name);
+
+    // Prepared map if ready, otherwise prepared now on the calling thread
+    QSharedPointer<const PreparedMap> take(const QString &name);
+
+    // Keep an already prepared map (the one being left) for a quick way back
+    void store(const QSharedPointer<const PreparedMap> &map);
+
+    // Forget prepared and in-flight maps not listed (e.g. after a transition)
+    void retainOnly(const QSet<QString> &names);
+
+    bool isReady(const QString &name) const { return ready.contains(name); }
+
+    // Decode one background chunk (Map_OW::readChunk) on the worker, ahead of
+    // any map prefetch, and call done with it on the GUI thread
+    void decodeChunk(const QString &chunkDir, const QString &background, int col, int row,
+                     const std::function<void(const QImage &)> &done);
+
+private:
+    friend class PrepareMapTask;
+    friend class DecodeChunkTask;
+
+    QThreadPool pool;  // One worker; its own pool so the destructor can wait for it
+    QHash<QString, QSharedPointer<const PreparedMap>> ready;
+    QSet<QString> inFlight;
+
+    void onPrepared(const QSharedPointer<const PreparedMap> &map);
+};
+
+#endif // MAPSTREAMER_OW_H
@@ -1,9 +1,15 @@
 #include "Map_OW.h"
+#include "MapStreamer_OW.h"
 #include <QDebug>
+#include <QImageReader>
+#include <QPointer>
 
 Map_OW::Map_OW(QObject *parent)
-    : QGraphicsScene(parent), background(nullptr)
+    : QGraphicsScene(parent)
 {
+    // A handful of chunks, the player and the menu: a linear scan beats
+    // keeping a BSP tree up to date every time the player moves
+    setItemIndexMethod(QGraphicsScene::NoIndex);
 }
 
 Map_OW::~Map_OW()
@@ -12,85 +18,251 @@ Map_OW::~Map_OW()
 
 void Map_OW::loadMap(const QString &name)
 {
-    currentMapName = name;
-    currentMap = MapLoader::load(name);
-    applyMap(currentMap);
+    applyPreparedMap(prepareMap(name));
 }
 
-void Map_OW::applyMap(const MapData &m)
+QSharedPointer<const PreparedMap> Map_OW::prepareMap(const QString &name)
 {
-    clear();
+    QSharedPointer<PreparedMap> map(new PreparedMap);
+    map->name = name;
+    map->data = MapLoader::load(name);
+
+    measureChunks(*map);
 
-    background = addPixmap(QPixmap(m.background));
-    background->setZValue(0);
+    // Classify the masks once; queries are then a single array load
+    buildAttributeGrid(*map, QImage(map->data.collision), QImage(map->data.tallgrass),
+                       QImage(map->data.exitMask));
 
-    if (!background->pixmap().isNull()) {
-        setSceneRect(
-            0, 0,
-            background->pixmap().width(),
-            background->pixmap().height()
-        );
+    // Alias tables per grass zone, so a roll in the grass is O(1)
+    map->encounterTables.resize(kGrassZones);
+    for (int zone = 0; zone < kGrassZones; ++zone) {
+        QVector<EncounterSlot> rows;
+        for (const EncounterSlot &slot : map->data.encounters) {
+            if (slot.zone == zone) rows.append(slot);
+        }
+        map->encounterTables[zone].build(rows);
     }
 
-    // Load masks
-    collisionMask = QImage(m.collision);
-    tallGrassMask = QImage(m.tallgrass);
-    exitMask = QImage(m.exitMask);
+    return map;
 }
 
-bool Map_OW::isSolidPixel(int x, int y) const
+void Map_OW::applyPreparedMap(const QSharedPointer<const PreparedMap> &map)
 {
-    if (x < 0 || y < 0 ||
-        x >= collisionMask.width() ||
-        y >= collisionMask.height())
-        return true;
+    // clear() deletes the chunk items along with everything else
+    clear();
+
+    prepared = map;
+    currentMapName = map->name;
+    currentMap = map->data;
+    chunkDir = map->data.chunkDir;
+    background = map->data.background;
+    exitAreas = map->exitAreas;
+    encounterTables = map->encounterTables;
+    encounterTables.resize(kGrassZones);
+
+    // Implicitly shared, so these copies are just reference bumps
+    attributes = map->attributes;
+    gridWidth = map->gridWidth;
+    gridHeight = map->gridHeight;
+    collision = map->collision;
+
+    chunkCols = map->chunkCols;
+    chunkRows = map->chunkRows;
+    residentChunks = 0;
+    wantedChunks = QRect();
+    ++mapGeneration;
+    chunks.clear();
+    chunks.resize(chunkCols * chunkRows);
 
-    QColor p = collisionMask.pixelColor(x, y);
-    return (p.red() < 30 && p.green() < 30 && p.blue() < 30);
+    if (map->size.isValid() && !map->size.isEmpty()) {
+        setSceneRect(0, 0, map->size.width(), map->size.height());
+    }
 }
 
-bool Map_OW::isSlowPixel(int x, int y) const
+void Map_OW::measureChunks(PreparedMap &map)
 {
-    if (x < 0 || y < 0 ||
-        x >= collisionMask.width() ||
-        y >= collisionMask.height())
-        return false;
+    // Only the header is read; chunks are decoded when they come into view
+    map.size = QImageReader(map.data.background).size();
+    if (!map.size.isValid())
+        map.size = QImageReader(map.data.collision).size();
+
+    if (!map.size.isValid() || map.size.isEmpty()) {
+        qDebug() << "Map has no background:" << map.data.background;
+        map.size = QSize();
+        return;
+    }
 
-    QColor p = collisionMask.pixelColor(x, y);
-    return (p.blue() > 200 && p.red() < 80 && p.green() < 80);
+    map.chunkCols = (map.size.width() + kChunkSize - 1) / kChunkSize;
+    map.chunkRows = (map.size.height() + kChunkSize - 1) / kChunkSize;
 }
 
-bool Map_OW::isGrassPixel(int x, int y) const
+QImage Map_OW::readChunk(const QString &chunkDir, const QString &background, int col, int row)
 {
-    if (x < 0 || y < 0 ||
-        x >= tallGrassMask.width() ||
-        y >= tallGrassMask.height())
-        return false;
+    if (!chunkDir.isEmpty()) {
+        QImage image(QString("%1/%2_%3.png").arg(chunkDir).arg(col).arg(row));
+        if (image.isNull())
+            qDebug() << "Missing map chunk" << col << row << "in" << chunkDir;
+        return image;
+    }
 
-    QColor px = tallGrassMask.pixelColor(x, y);
-    return (px.red() > 200 && px.blue() > 200 && px.green() < 100);
+    // No pre-cut chunks: clip this one out of the full background. PNG has
+    // no partial decode, so this costs a full decode, but nothing is kept.
+    QImageReader reader(background);
+    const QRect area = QRect(col * kChunkSize, row * kChunkSize, kChunkSize, kChunkSize)
+                       & QRect(QPoint(), reader.size());  // Edge chunks are clipped to the map
+    reader.setClipRect(area);
+    return reader.read();
 }
 
-QString Map_OW::detectExitAtPlayerPosition(QGraphicsItem *player) const
+void Map_OW::showChunk(int col, int row, const QImage &image)
 {
-    if (exitMask.isNull() || !player) return "";
+    BackgroundChunk &chunk = chunks[row * chunkCols + col];
+    chunk.pending = false;
+    chunk.item = addPixmap(QPixmap::fromImage(image));
+    chunk.item->setPos(col * kChunkSize, row * kChunkSize);
+    chunk.item->setZValue(0);
+    ++residentChunks;
+}
 
-    int px = player->x() + player->boundingRect().width()/2;
-    int py = player->y() + player->boundingRect().height() - 4;
+void Map_OW::updateVisibleChunks(const QRectF &visibleRect)
+{
+    if (chunks.isEmpty()) return;
 
-    if (px < 0 || py < 0 || px >= exitMask.width() || py >= exitMask.height())
-        return "";
+    // Half a chunk of margin so chunks are ready just before they scroll in
+    const QRectF wanted = visibleRect.adjusted(-kChunkSize / 2, -kChunkSize / 2,
+                                               kChunkSize / 2, kChunkSize / 2);
+    const int col0 = qMax(0, static_cast<int>(wanted.left()) / kChunkSize);
+    const int row0 = qMax(0, static_cast<int>(wanted.top()) / kChunkSize);
+    const int col1 = qMin(chunkCols - 1, static_cast<int>(wanted.right()) / kChunkSize);
+    const int row1 = qMin(chunkRows - 1, static_cast<int>(wanted.bottom()) / kChunkSize);
+    wantedChunks = QRect(QPoint(col0, row0), QPoint(col1, row1));
 
-    QColor c = exitMask.pixelColor(px, py);
+    for (int row = 0; row < chunkRows; ++row) {
+        for (int col = 0; col < chunkCols; ++col) {
+            BackgroundChunk &chunk = chunks[row * chunkCols + col];
+            const bool keep = wantedChunks.contains(col, row);
 
-    // EXIT COLORS:
-    if (c.red() > 200 && c.green() < 50 && c.blue() < 50)
-        return "house1_door";
-    if (c.blue() > 200 && c.red() < 50 && c.green() < 50)
-        return "cave_entrance";
-    if (c.green() > 200 && c.red() < 50 && c.blue() < 50)
-        return "exit_door";
+            if (keep && !chunk.item) {
+                const QRectF area(col * kChunkSize, row * kChunkSize, kChunkSize, kChunkSize);
+                if (!streamer || area.intersects(visibleRect)) {
+                    // On screen now (first frame, or a jump): can't wait for the worker
+                    showChunk(col, row, readChunk(chunkDir, background, col, row));
+                } else if (!chunk.pending) {
+                    chunk.pending = true;
+                    QPointer<Map_OW> self(this);
+                    const int generation = mapGeneration;
+                    streamer->decodeChunk(chunkDir, background, col, row,
+                                          [self, generation, col, row](const QImage &image) {
+                        if (!self || self->mapGeneration != generation) return;
+                        BackgroundChunk &late = self->chunks[row * self->chunkCols + col];
+                        late.pending = false;
+                        // Scrolled away again, or decoded synchronously in the meantime
+                        if (late.item || !self->wantedChunks.contains(col, row)) return;
+                        self->showChunk(col, row, image);
+                    });
+                }
+            } else if (!keep && chunk.item) {
+                removeItem(chunk.item);
+                delete chunk.item;
+                chunk.item = nullptr;
+                --residentChunks;
+            }
+        }
+    }
+}
 
-    return "";
+QString Map_OW::exitName(int exitId)
+{
+    // EXIT COLORS: red, blue, green in the exit mask
+    switch (exitId) {
+        case 1: return "house1_door";
+        case 2: return "cave_entrance";
+        case 3: return "exit_door";
+        default: return "";
+    }
 }
 
+void Map_OW::buildAttributeGrid(PreparedMap &map, const QImage &collisionMask,
+                                const QImage &tallGrass, const QImage &exits)
+{
+    const int gridWidth = collisionMask.width();
+    const int gridHeight = collisionMask.height();
+    map.attributes.fill(0, gridWidth * gridHeight);
+    if (map.attributes.isEmpty()) {
+        map.gridWidth = 0;
+        map.gridHeight = 0;
+        return;
+    }
+    map.gridWidth = gridWidth;
+    map.gridHeight = gridHeight;
+
+    // ARGB32 keeps the stored channels as-is, so thresholds match the old pixelColor() checks
+    const QImage col = collisionMask.convertToFormat(QImage::Format_ARGB32);
+    const QImage grass = tallGrass.isNull() ? QImage() : tallGrass.convertToFormat(QImage::Format_ARGB32);
+    const QImage exit = exits.isNull() ? QImage() : exits.convertToFormat(QImage::Format_ARGB32);
+
+    QRect exitBounds[4];
+
+    for (int y = 0; y < gridHeight; ++y) {
+        quint8 *row = map.attributes.data() + y * gridWidth;
+        const QRgb *colRow = reinterpret_cast<const QRgb *>(col.constScanLine(y));
+        const QRgb *grassRow = y < grass.height() ? reinterpret_cast<const QRgb *>(grass.constScanLine(y)) : nullptr;
+        const QRgb *exitRow = y < exit.height() ? reinterpret_cast<const QRgb *>(exit.constScanLine(y)) : nullptr;
+        const int grassWidth = qMin(grass.width(), gridWidth);
+        const int exitWidth = qMin(exit.width(), gridWidth);
+
+        for (int x = 0; x < gridWidth; ++x) {
+            const QRgb p = colRow[x];
+            const int r = qRed(p), g = qGreen(p), b = qBlue(p);
+            quint8 attr = 0;
+            if (r < 30 && g < 30 && b < 30)
+                attr |= TileSolid;
+            if (b > 200 && r < 80 && g < 80)
+                attr |= TileSlow;
+
+            if (grassRow && x < grassWidth) {
+                const QRgb gp = grassRow[x];
+                if (qRed(gp) > 200 && qBlue(gp) > 200 && qGreen(gp) < 100) {
+                    // Green 0-24 is zone 0, 25-49 zone 1, and so on
+                    attr |= TileGrass;
+                    attr |= static_cast<quint8>((qGreen(gp) / 25) << TileGrassZoneShift);
+                }
+            }
+
+            if (exitRow && x < exitWidth) {
+                const QRgb ep = exitRow[x];
+                const int er = qRed(ep), eg = qGreen(ep), eb = qBlue(ep);
+                int exitId = 0;
+                if (er > 200 && eg < 50 && eb < 50)
+                    exitId = 1;
+                else if (eb > 200 && er < 50 && eg < 50)
+                    exitId = 2;
+                else if (eg > 200 && er < 50 && eb < 50)
+                    exitId = 3;
+                if (exitId) {
+                    attr |= static_cast<quint8>(exitId << TileExitShift);
+                    exitBounds[exitId] |= QRect(x, y, 1, 1);
+                }
+            }
+
+            row[x] = attr;
+        }
+    }
+
+    for (int exitId = 1; exitId < 4; ++exitId) {
+        if (!exitBounds[exitId].isNull())
+            map.exitAreas.insert(exitName(exitId), exitBounds[exitId]);
+    }
+
+    map.collision.build(map.attributes.constData(), gridWidth, gridHeight, TileSolid);
+}
+
+QString Map_OW::detectExitAtPlayerPosition(QGraphicsItem *player) const
+{
+    if (!player) return "";
+
+    int px = player->x() + player->boundingRect().width()/2;
+    int py = player->y() + player->boundingRect().height() - 4;
+
+    return exitName(exitIdAt(px, py));
+}
@@ -5,7 +5,46 @@
 #include <QGraphicsPixmapItem>
 #include <QImage>
 #include <QString>
+#include <QVector>
+#include <QMap>
+#include <QRect>
+#include <QSharedPointer>
 #include "map_loader.h"
+#include "Collision_OW.h"
+#include "EncounterTable_OW.h"
+
+class MapStreamer_OW;
+
+// Per-pixel attribute bits, classified once when a map is loaded
+enum TileAttribute : quint8 {
+    TileSolid = 0x01,       // collision.png: near-black
+    TileSlow = 0x02,        // collision.png: blue
+    TileGrass = 0x04,       // tallgrass.png: magenta
+    TileExitShift = 3,      // exit mask id (see Map_OW::exitName) in bits 3-5
+    TileExitMask = 0x38,
+    TileGrassZoneShift = 6, // tallgrass.png green channel / 25 in bits 6-7
+    TileGrassZoneMask = 0xC0
+};
+
+// Each grass zone has its own encounter table
+static const int kGrassZones = 4;
+
+// Everything decoded for one map. Built without touching the scene, so it
+// can be prepared on a worker thread (see MapStreamer_OW) and swapped in later.
+struct PreparedMap
+{
+    QString name;
+    MapData data;
+    QSize size;
+    int chunkCols = 0;
+    int chunkRows = 0;
+    QVector<quint8> attributes;   // gridWidth * gridHeight, row-major
+    int gridWidth = 0;
+    int gridHeight = 0;
+    Collision_OW collision;
+    QMap<QString, QRect> exitAreas;  // Bounding box of each exit in the exit mask
+    QVector<EncounterTable_OW> encounterTables;  // One per grass zone
+};
 
 class Map_OW : public QGraphicsScene
 {
@@ -16,28 +55,87 @@ public:
     ~Map_OW();
 
     void loadMap(const QString &name);
-    void applyMap(const MapData &m);
+
+    // Decode backgrounds and masks for a map. Safe to call from any thread.
+    static QSharedPointer<const PreparedMap> prepareMap(const QString &name);
+    // Swap a prepared map into the scene (GUI thread)
+    void applyPreparedMap(const QSharedPointer<const PreparedMap> &map);
     
+    // Attribute lookup. Outside the collision mask everything is solid.
+    quint8 tileAttributes(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= gridWidth || y >= gridHeight)
+            return TileSolid;
+        return attributes[y * gridWidth + x];
+    }
+
     // Collision detection
-    bool isSolidPixel(int x, int y) const;
-    bool isSlowPixel(int x, int y) const;
-    bool isGrassPixel(int x, int y) const;
+    bool isSolidPixel(int x, int y) const { return tileAttributes(x, y) & TileSolid; }
+    bool isSlowPixel(int x, int y) const { return tileAttributes(x, y) & TileSlow; }
+    bool isGrassPixel(int x, int y) const { return tileAttributes(x, y) & TileGrass; }
+    int exitIdAt(int x, int y) const { return (tileAttributes(x, y) & TileExitMask) >> TileExitShift; }
+    int grassZoneAt(int x, int y) const { return (tileAttributes(x, y) & TileGrassZoneMask) >> TileGrassZoneShift; }
+
+    // Wild encounters for a grass zone (empty if the map defines none)
+    const EncounterTable_OW& encounterTable(int zone) const { return encounterTables[qBound(0, zone, kGrassZones - 1)]; }
+    static QString exitName(int exitId);
+
+    // Bit-packed copy of the solid bits for swept rectangle tests
+    const Collision_OW& getCollision() const { return collision; }
     
     // Exit detection
     QString detectExitAtPlayerPosition(QGraphicsItem *player) const;
     
+    // Background chunks. Only chunks overlapping the visible scene rect
+    // (plus a margin) have a pixmap item; call after the camera moves.
+    // Chunks on screen are decoded straight away, chunks only in the margin
+    // on the streamer's worker thread when one is set.
+    static constexpr int kChunkSize = 256;
+    void updateVisibleChunks(const QRectF &visibleRect);
+    int residentChunkCount() const { return residentChunks; }
+    void setStreamer(MapStreamer_OW *mapStreamer) { streamer = mapStreamer; }
+
+    // One chunk of a background: its pre-cut file if chunkDir is set,
+    // otherwise clipped out of the full image. Safe to call from any thread.
+    static QImage readChunk(const QString &chunkDir, const QString &background, int col, int row);
+
     // Getters
     QString getCurrentMapName() const { return currentMapName; }
     MapData getCurrentMap() const { return currentMap; }
-    QGraphicsPixmapItem* getBackground() const { return background; }
+    QMap<QString, QRect> getExitAreas() const { return exitAreas; }
+    QSharedPointer<const PreparedMap> getPreparedMap() const { return prepared; }
 
 private:
-    QGraphicsPixmapItem *background;
-    QImage collisionMask;
-    QImage tallGrassMask;
-    QImage exitMask;
+    struct BackgroundChunk {
+        QGraphicsPixmapItem *item = nullptr;   // Only while visible
+        bool pending = false;                  // Decode requested from the streamer
+    };
+    QVector<BackgroundChunk> chunks;  // chunkCols * chunkRows, row-major
+    int chunkCols = 0;
+    int chunkRows = 0;
+    int residentChunks = 0;
+    QRect wantedChunks;    // Column/row range from the last updateVisibleChunks()
+    int mapGeneration = 0; // Bumped per map so late decodes for the old one are dropped
+    QString chunkDir;
+    QString background;
+    MapStreamer_OW *streamer = nullptr;
+    QMap<QString, QRect> exitAreas;
+    QVector<EncounterTable_OW> encounterTables = QVector<EncounterTable_OW>(kGrassZones);
+
+    void showChunk(int col, int row, const QImage &image);
+    QVector<quint8> attributes;  // gridWidth * gridHeight, row-major
+    int gridWidth = 0;
+    int gridHeight = 0;
+    Collision_OW collision;
     QString currentMapName;
     MapData currentMap;
+    QSharedPointer<const PreparedMap> prepared;
+
+    // Size the chunk grid from the background's header; nothing is decoded
+    static void measureChunks(PreparedMap &map);
+    // Fold collision, tall grass and exit masks into the attribute grid
+    static void buildAttributeGrid(PreparedMap &map, const QImage &collisionMask,
+                                   const QImage &tallGrass, const QImage &exits);
 };
 
 #endif // MAP_OW_H
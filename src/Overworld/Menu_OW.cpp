@@ -1,11 +1,20 @@
 #include "Menu_OW.h"
 #include "../Battle/Battle_logic/Pokemon.h"
+#include "../General/sprite_cache.h"
+#include "../General/game_view.h"
 #include <QFont>
 #include <QPainter>
 #include <QPolygonF>
 #include <QDebug>
 #include <QGraphicsView>
 
+// Menus are painted by GameView after the pixel upscale, so text stays sharp
+static void placeOverlay(QGraphicsItem *item, qreal z)
+{
+    item->setZValue(z);
+    GameView::markOverlay(item);
+}
+
 Menu_OW::Menu_OW(QGraphicsScene *scene, QGraphicsView *view, QObject *parent)
     : QObject(parent), scene(scene), view(view)
 {
@@ -38,13 +47,13 @@ void Menu_OW::showMenu()
     QGraphicsRectItem *shadow = new QGraphicsRectItem(boxX + 3, boxY + 3, boxW, boxH);
     shadow->setBrush(QColor(0, 0, 0, 100));
     shadow->setPen(Qt::NoPen);
-    shadow->setZValue(9);
+    placeOverlay(shadow, kShadowZ);
     scene->addItem(shadow);
 
     menuRect = new QGraphicsRectItem(boxX, boxY, boxW, boxH);
     menuRect->setBrush(QColor(245, 245, 220)); // Beige background like battle menu
     menuRect->setPen(QPen(QColor(70, 130, 180), 3)); // Blue border
-    menuRect->setZValue(10);
+    placeOverlay(menuRect, kBoxZ);
     scene->addItem(menuRect);
 
     menuOptions.clear();
@@ -54,13 +63,13 @@ void Menu_OW::showMenu()
         t->setFont(font);
         t->setDefaultTextColor(QColor(44, 62, 80)); // Dark blue-gray text
         t->setPos(boxX + 20, boxY + 15 + i * 20);
-        t->setZValue(11);
+        placeOverlay(t, kTextZ);
         scene->addItem(t);
         menuOptions.push_back(t);
     }
 
     // Cursor
-    QPixmap arrow(":/assets/battle/ui/arrow_cursor.png");
+    QPixmap arrow = SpriteCache::pixmap(":/assets/battle/ui/arrow_cursor.png");
     if (arrow.isNull()) {
         arrow = QPixmap(20, 20);
         arrow.fill(Qt::transparent);
@@ -75,7 +84,7 @@ void Menu_OW::showMenu()
     }
     cursorSprite = scene->addPixmap(arrow);
     cursorSprite->setScale(1.5);
-    cursorSprite->setZValue(15);
+    placeOverlay(cursorSprite, kCursorZ);
     cursorSprite->setVisible(true);
 
     inMenu = true;
@@ -253,13 +262,13 @@ void Menu_OW::showPokemonMenu()
     QGraphicsRectItem *shadow = new QGraphicsRectItem(boxX + 3, boxY + 3, boxW, boxH);
     shadow->setBrush(QColor(0, 0, 0, 100));
     shadow->setPen(Qt::NoPen);
-    shadow->setZValue(9);
+    placeOverlay(shadow, kShadowZ);
     scene->addItem(shadow);
 
     pokemonMenuRect = new QGraphicsRectItem(boxX, boxY, boxW, boxH);
     pokemonMenuRect->setBrush(QColor(245, 245, 220));
     pokemonMenuRect->setPen(QPen(QColor(70, 130, 180), 3));
-    pokemonMenuRect->setZValue(10);
+    placeOverlay(pokemonMenuRect, kBoxZ);
     scene->addItem(pokemonMenuRect);
 
     pokemonMenuOptions.clear();
@@ -291,13 +300,13 @@ void Menu_OW::showPokemonMenu()
         t->setFont(font);
         t->setDefaultTextColor(textColor);
         t->setPos(boxX + 12, boxY + 8 + i * 16);
-        t->setZValue(11);
+        placeOverlay(t, kTextZ);
         scene->addItem(t);
         pokemonMenuOptions.push_back(t);
     }
 
     if (!cursorSprite) {
-        QPixmap arrow(":/assets/battle/ui/arrow_cursor.png");
+        QPixmap arrow = SpriteCache::pixmap(":/assets/battle/ui/arrow_cursor.png");
         if (arrow.isNull()) {
             arrow = QPixmap(20, 20);
             arrow.fill(Qt::transparent);
@@ -312,7 +321,7 @@ void Menu_OW::showPokemonMenu()
         }
         cursorSprite = scene->addPixmap(arrow);
         cursorSprite->setScale(1.5);
-        cursorSprite->setZValue(15);
+        placeOverlay(cursorSprite, kCursorZ);
     }
     cursorSprite->setVisible(true);
 
@@ -354,13 +363,13 @@ void Menu_OW::showPokemonListMenu(int slotIndex)
     QGraphicsRectItem *shadow = new QGraphicsRectItem(boxX + 3, boxY + 3, boxW, boxH);
     shadow->setBrush(QColor(0, 0, 0, 100));
     shadow->setPen(Qt::NoPen);
-    shadow->setZValue(9);
+    placeOverlay(shadow, kShadowZ);
     scene->addItem(shadow);
 
     pokemonListMenuRect = new QGraphicsRectItem(boxX, boxY, boxW, boxH);
     pokemonListMenuRect->setBrush(QColor(245, 245, 220));
     pokemonListMenuRect->setPen(QPen(QColor(70, 130, 180), 3));
-    pokemonListMenuRect->setZValue(10);
+    placeOverlay(pokemonListMenuRect, kBoxZ);
     scene->addItem(pokemonListMenuRect);
 
     pokemonListMenuOptions.clear();
@@ -377,7 +386,7 @@ void Menu_OW::showPokemonListMenu(int slotIndex)
         t->setFont(font);
         t->setDefaultTextColor(QColor(44, 62, 80));
         t->setPos(boxX + 12, boxY + 8 + static_cast<int>(i) * 16);
-        t->setZValue(11);
+        placeOverlay(t, kTextZ);
         scene->addItem(t);
         pokemonListMenuOptions.push_back(t);
     }
@@ -386,7 +395,7 @@ void Menu_OW::showPokemonListMenu(int slotIndex)
     back->setFont(font);
     back->setDefaultTextColor(QColor(44, 62, 80));
     back->setPos(boxX + 12, boxY + 8 + static_cast<int>(team.size()) * 16);
-    back->setZValue(11);
+    placeOverlay(back, kTextZ);
     scene->addItem(back);
     pokemonListMenuOptions.push_back(back);
 
@@ -22,6 +22,12 @@ public:
     void hideMenu();
     void handleKey(QKeyEvent *event);
     bool isInMenu() const { return inMenu || inPokemonMenu || inPokemonListMenu; }
+
+    // Menu layers, above the map and the player
+    static constexpr qreal kShadowZ = 9;
+    static constexpr qreal kBoxZ = 10;
+    static constexpr qreal kTextZ = 11;
+    static constexpr qreal kCursorZ = 15;
     
     void setPlayer(Player *player) { gamePlayer = player; }
 
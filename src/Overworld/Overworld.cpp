@@ -1,4 +1,6 @@
 #include "Overworld.h"
+#include "../General/sprite_cache.h"
+#include "../General/frame_profiler.h"
 #include <QDebug>
 
 Overworld::Overworld(QGraphicsScene *scene, QGraphicsView *view)
@@ -14,6 +16,10 @@ Overworld::Overworld(QGraphicsScene *scene, QGraphicsView *view)
         view->setScene(mapOW);
     }
     
+    // Background preparation of neighbouring maps
+    streamer = new MapStreamer_OW(this);
+    mapOW->setStreamer(streamer);
+
     // Create camera (uses the existing view)
     cameraOW = new Camera_OW(view);
     
@@ -38,12 +44,30 @@ Overworld::~Overworld()
 
 void Overworld::loadMap(const QString &name)
 {
+    PROFILE_ZONE("overworld.loadMap");
     // Remove player from scene before clearing (so it doesn't get deleted)
     if (playerOW && mapOW->items().contains(playerOW)) {
         mapOW->removeItem(playerOW);
     }
     
-    mapOW->loadMap(name);
+    // Prefetched maps swap straight in; anything else is decoded now
+    QSharedPointer<const PreparedMap> previous = mapOW->getPreparedMap();
+    mapOW->applyPreparedMap(streamer->take(name));
+
+    // Keep only the new map's neighbours, including the one we just left
+    QSet<QString> neighbours;
+    for (const QString &target : mapOW->getCurrentMap().exits) {
+        neighbours.insert(target);
+    }
+    if (previous && neighbours.contains(previous->name)) {
+        streamer->store(previous);
+    }
+    streamer->retainOnly(neighbours);
+
+    // Wild Pokemon here will need their front sprites in the next battle
+    for (const EncounterSlot &slot : mapOW->getCurrentMap().encounters) {
+        SpriteCache::prefetchPokemon(slot.dexNumber, true);
+    }
     
     // Re-add player to scene after map is loaded
     if (playerOW) {
@@ -52,10 +76,12 @@ void Overworld::loadMap(const QString &name)
         // Set player position to spawn
         MapData currentMap = mapOW->getCurrentMap();
         playerOW->setPosition(currentMap.playerSpawn);
+        resetInterpolation();
+        grassDistance = 0;
     }
     
     if (cameraOW && playerOW) {
-        cameraOW->updateCamera(playerOW);
+        updateView();
     }
 }
 
@@ -65,77 +91,144 @@ void Overworld::checkForMapExit()
     if (exitId.isEmpty()) return;
 
     MapData currentMap = mapOW->getCurrentMap();
-    if (currentMap.exits.contains(exitId)) {
-        loadMap(currentMap.exits[exitId]);
-    }
+    if (!currentMap.exits.contains(exitId)) return;
+
+    // validate_maps.py rejects these at build time; don't fall through to the default map
+    QString target = currentMap.exits[exitId];
+    if (!MapLoader::hasMap(target)) return;
+
+    loadMap(target);
 }
 
-void Overworld::handleMovementInput(QKeyEvent *event)
+void Overworld::stepMovement(int dx, int dy, qreal dt)
 {
-    float dx=0, dy=0;
-    QString direction;
-
-    switch(event->key()) {
-    case Qt::Key_W: dy = -1; direction="back";  break;
-    case Qt::Key_S: dy = +1; direction="front"; break;
-    case Qt::Key_A: dx = -1; direction="left";  break;
-    case Qt::Key_D: dx = +1; direction="right"; break;
-    default: return;
+    PROFILE_ZONE("overworld.step");
+    if (dx == 0 && dy == 0) {
+        stopMovement();
+        return;
     }
 
+    // Sideways wins when moving diagonally, same as the lab
+    QString direction;
+    if (dy < 0) direction = "back";
+    if (dy > 0) direction = "front";
+    if (dx < 0) direction = "left";
+    if (dx > 0) direction = "right";
     playerOW->setDirection(direction);
-    QPointF oldPos = playerOW->getPosition();
-    QPointF tryPos(oldPos.x() + dx * speed,
-                   oldPos.y() + dy * speed);
+
+    if (!simValid) resetInterpolation();
+    prevSimPos = simPos;
+
+    const qreal step = speed * dt;
+    QPointF tryPos(simPos.x() + dx * step,
+                   simPos.y() + dy * step);
 
     int px = tryPos.x() + playerOW->boundingRect().width()/2;
     int py = tryPos.y() + playerOW->boundingRect().height() - 4;
 
-    float finalSpeed = speed;
+    qreal finalStep = step;
     if (mapOW->isSlowPixel(px, py))
-        finalSpeed = speed * 0.4f;
+        finalStep = step * 0.4;
 
-    tryPos = QPointF(oldPos.x() + dx * finalSpeed,
-                     oldPos.y() + dy * finalSpeed);
+    // Sweep the feet rather than probing one pixel at the destination, so the
+    // player slides up flush against walls instead of stopping short
+    QPointF allowed = mapOW->getCollision().sweep(footRect(simPos),
+                                                  QPointF(dx * finalStep, dy * finalStep));
+    simPos = clampPosition(simPos + allowed);
 
-    px = tryPos.x() + playerOW->boundingRect().width()/2;
-    py = tryPos.y() + playerOW->boundingRect().height() - 4;
+    // Game logic sees the simulated position; renderInterpolated() puts the
+    // sprite back between the last two steps before the frame is painted
+    playerOW->setPosition(simPos);
 
-    if (!mapOW->isSolidPixel(px, py))
-        playerOW->setPosition(tryPos);
+    px = simPos.x() + playerOW->boundingRect().width()/2;
+    py = simPos.y() + playerOW->boundingRect().height() - 4;
 
-    cameraOW->updateCamera(playerOW);
+    prefetchNearbyExits(px, py);
 
-    if (mapOW->isGrassPixel(px, py))
-        tryWildEncounter();
+    if (mapOW->isGrassPixel(px, py)) {
+        // Roll once per kEncounterStride pixels walked so the encounter rate
+        // doesn't depend on the tick rate
+        grassDistance += qAbs(allowed.x()) + qAbs(allowed.y());
+        while (grassDistance >= kEncounterStride) {
+            grassDistance -= kEncounterStride;
+            if (tryWildEncounter(mapOW->grassZoneAt(px, py))) {
+                grassDistance = 0;
+                break;
+            }
+        }
+    }
 
     checkForMapExit();
 
-    if (!isMoving && (dx!=0 || dy!=0)) {
+    if (!isMoving) {
         isMoving = true;
         playerOW->startAnimation();
     }
-
-    clampPlayer();
 }
 
-void Overworld::handleKeyRelease(QKeyEvent *event)
+void Overworld::prefetchNearbyExits(int px, int py)
 {
-    if (event->key()==Qt::Key_W ||
-        event->key()==Qt::Key_A ||
-        event->key()==Qt::Key_S ||
-        event->key()==Qt::Key_D)
-    {
-        isMoving = false;
-        playerOW->stopAnimation();
-        cameraOW->updateCamera(playerOW);
+    const QMap<QString, QRect> exitAreas = mapOW->getExitAreas();
+    if (exitAreas.isEmpty()) return;
+
+    const QMap<QString, QString> exits = mapOW->getCurrentMap().exits;
+    for (auto it = exitAreas.constBegin(); it != exitAreas.constEnd(); ++it) {
+        QRect nearby = it.value().adjusted(-kPrefetchDistance, -kPrefetchDistance,
+                                           kPrefetchDistance, kPrefetchDistance);
+        if (nearby.contains(px, py) && exits.contains(it.key())) {
+            streamer->prefetch(exits.value(it.key()));
+        }
     }
 }
 
-void Overworld::clampPlayer()
+void Overworld::stopMovement()
+{
+    if (!isMoving) return;
+
+    isMoving = false;
+    playerOW->stopAnimation();
+    // Next render lands exactly on the final step
+    prevSimPos = simPos;
+}
+
+void Overworld::renderInterpolated(qreal alpha)
+{
+    PROFILE_ZONE("overworld.render");
+    if (!simValid) return;
+
+    QPointF drawPos = prevSimPos + (simPos - prevSimPos) * alpha;
+    if (drawPos == playerOW->getPosition()) return;
+
+    playerOW->setPosition(drawPos);
+    updateView();
+}
+
+void Overworld::updateView()
+{
+    cameraOW->updateCamera(playerOW);
+    mapOW->updateVisibleChunks(cameraOW->visibleSceneRect());
+}
+
+void Overworld::resetInterpolation()
+{
+    simPos = playerOW->getPosition();
+    prevSimPos = simPos;
+    simValid = true;
+}
+
+QRectF Overworld::footRect(const QPointF &pos) const
+{
+    // A few pixels around the old single foot probe (w/2, h-4)
+    QRectF bounds = playerOW->boundingRect();
+    qreal footWidth = qMax<qreal>(2.0, bounds.width() / 4);
+    return QRectF(pos.x() + bounds.width()/2 - footWidth/2,
+                  pos.y() + bounds.height() - 6,
+                  footWidth, 3);
+}
+
+QPointF Overworld::clampPosition(QPointF pos) const
 {
     QRectF bounds = playerOW->boundingRect();
-    QPointF pos = playerOW->getPosition();
     QRectF mapRect = mapOW->sceneRect();
 
     if (pos.x() < mapRect.left()) pos.setX(mapRect.left());
@@ -144,14 +237,36 @@ void Overworld::clampPlayer()
     if (pos.y() < mapRect.top()) pos.setY(mapRect.top());
     if (pos.y() > mapRect.bottom()-bounds.height()) pos.setY(mapRect.bottom()-bounds.height());
 
-    playerOW->setPosition(pos);
+    return pos;
 }
 
-void Overworld::tryWildEncounter()
+void Overworld::clampPlayer()
 {
-    if (QRandomGenerator::global()->bounded(100) < 2) {
-        emit wildEncounterTriggered();
+    playerOW->setPosition(clampPosition(playerOW->getPosition()));
+    resetInterpolation();
+}
+
+bool Overworld::tryWildEncounter(int zone)
+{
+    QRandomGenerator *rng = QRandomGenerator::global();
+    if (rng->bounded(100) >= mapOW->getCurrentMap().encounterRate)
+        return false;
+
+    int dexNumber = 0;
+    int level = 5;
+    const EncounterTable_OW &table = mapOW->encounterTable(zone);
+    if (table.isEmpty()) {
+        // A map with tables only has encounters where it defines them;
+        // one with none at all keeps the old anything-goes roll
+        if (!mapOW->getCurrentMap().encounters.isEmpty())
+            return false;
+        dexNumber = rng->bounded(1, 152); // 1-151
+    } else {
+        table.sample(rng, &dexNumber, &level);
     }
+
+    emit wildEncounterTriggered(dexNumber, level);
+    return true;
 }
 
 void Overworld::setPlayer(Player *player)
@@ -164,8 +279,9 @@ void Overworld::setPlayerPosition(const QPointF &pos)
 {
     if (playerOW) {
         playerOW->setPosition(pos);
+        resetInterpolation();
         if (cameraOW) {
-            cameraOW->updateCamera(playerOW);
+            updateView();
         }
     }
 }
@@ -8,6 +8,7 @@
 #include "Camera_OW.h"
 #include "Map_OW.h"
 #include "Menu_OW.h"
+#include "MapStreamer_OW.h"
 #include "../Battle/Battle_logic/Player.h"
 
 class Overworld : public QObject
@@ -22,9 +23,13 @@ public:
     void loadMap(const QString &name);
     void checkForMapExit();
 
-    // Movement and collision
-    void handleMovementInput(QKeyEvent *event);
-    void handleKeyRelease(QKeyEvent *event);
+    // Movement and collision. stepMovement() advances one fixed simulation
+    // step with the held direction (-1, 0 or 1 per axis); renderInterpolated()
+    // draws the player between the last two steps.
+    void stepMovement(int dx, int dy, qreal dt);
+    void stopMovement();
+    void renderInterpolated(qreal alpha);
+    bool isPlayerMoving() const { return isMoving; }
     void clampPlayer();
 
     // Player management
@@ -32,8 +37,9 @@ public:
     Player* getPlayer() const { return gamePlayer; }
     void setPlayerPosition(const QPointF &pos);
 
-    // Wild encounters
-    void tryWildEncounter();
+    // Wild encounters. Rolls the map's encounter rate and, on a hit, samples
+    // the grass zone's table. Returns true if an encounter was triggered.
+    bool tryWildEncounter(int zone);
 
     // Overworld menu
     void showOverworldMenu();
@@ -47,7 +53,7 @@ public:
     Camera_OW* getCamera() const { return cameraOW; }
 
 signals:
-    void wildEncounterTriggered();
+    void wildEncounterTriggered(int dexNumber, int level);
     void pvpBattleRequested();
 
 private:
@@ -55,11 +61,31 @@ private:
     Camera_OW *cameraOW;
     Player_OW *playerOW;
     Menu_OW *menu;
+    MapStreamer_OW *streamer;
     QGraphicsView *view;
 
+    // Start preparing the map behind any exit within kPrefetchDistance of the feet
+    void prefetchNearbyExits(int px, int py);
+    static constexpr int kPrefetchDistance = 96;
+
     // Movement
-    float speed = 2.0f;
+    float speed = 40.0f;  // Pixels per second (the old 2 px per 50 ms key repeat)
     bool isMoving = false;
+    QRectF footRect(const QPointF &pos) const;
+    QPointF clampPosition(QPointF pos) const;
+
+    // Simulated position for the current and previous step
+    QPointF simPos;
+    QPointF prevSimPos;
+    bool simValid = false;
+    void resetInterpolation();
+
+    // Re-centre the camera and page background chunks in or out
+    void updateView();
+
+    // Distance walked in grass since the last encounter roll
+    qreal grassDistance = 0;
+    static constexpr qreal kEncounterStride = 2.0;
 
     // Player reference
     Player *gamePlayer = nullptr;
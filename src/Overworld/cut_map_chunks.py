@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+"""
+Script to cut a map background into 256x256 chunks for Map_OW.
+Writes "<col>_<row>.png" files (edge chunks are clipped to the map) into
+the output directory. Point MapData::chunkDir at that directory and the
+game loads each chunk only while it is on screen.
+
+Usage: cut_map_chunks.py assets/maps/route6/background.png assets/maps/route6/chunks
+"""
+
+import os
+import sys
+
+from PIL import Image
+
+CHUNK_SIZE = 256  # Must match Map_OW::kChunkSize
+
+def cut_map_chunks(background_path, output_dir):
+    """Split the background image into CHUNK_SIZE tiles."""
+
+    image = Image.open(background_path)
+    width, height = image.size
+    os.makedirs(output_dir, exist_ok=True)
+
+    count = 0
+    for row in range(0, (height + CHUNK_SIZE - 1) // CHUNK_SIZE):
+        for col in range(0, (width + CHUNK_SIZE - 1) // CHUNK_SIZE):
+            left = col * CHUNK_SIZE
+            top = row * CHUNK_SIZE
+            box = (left, top, min(left + CHUNK_SIZE, width), min(top + CHUNK_SIZE, height))
+            image.crop(box).save(os.path.join(output_dir, f"{col}_{row}.png"), optimize=True)
+            count += 1
+
+    print(f"Wrote {count} chunks for {width}x{height} map to {output_dir}")
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+
+    if not os.path.exists(sys.argv[1]):
+        print(f"Error: File {sys.argv[1]} not found")
+        sys.exit(1)
+
+    cut_map_chunks(sys.argv[1], sys.argv[2])
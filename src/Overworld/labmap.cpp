@@ -1,5 +1,6 @@
 #include "labmap.h"
 #include "Player_OW.h"
+#include "../General/sprite_cache.h"
 #include <QKeyEvent>
 #include <QShowEvent>
 #include <QFont>
@@ -17,7 +18,7 @@ LabMap::LabMap(QWidget *parent)
     isInitialDialogue(true),
     isSelectingStarter(false),
     selectedStarterIndex(0),
-    speed(1.5f),
+    speed(90.0f),
     bgXOffset(0),
     bgYOffset(0),
     hasShownInitialDialogue(false),
@@ -94,18 +95,16 @@ LabMap::LabMap(QWidget *parent)
     textBoxLabel->hide();
     textBoxLabel->raise();
 
-    dialogueLabel = new QLabel(this);
-    dialogueLabel->setGeometry(35, 200, 380, 50);
-    dialogueLabel->setWordWrap(true);
-    dialogueLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
-
     QFont font;
     font.setFamily("Courier");
     font.setPointSize(9);
     font.setStyleHint(QFont::TypeWriter);
     font.setBold(true);
-    dialogueLabel->setFont(font);
-    dialogueLabel->setStyleSheet("color: black; background: transparent;");
+
+    dialogueLabel = new GlyphLabel(font, Qt::black, this);
+    dialogueLabel->setGeometry(35, 200, 380, 50);
+    dialogueLabel->setWordWrap(true);
+    dialogueLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
     dialogueLabel->hide();
     dialogueLabel->raise();
 
@@ -189,9 +188,9 @@ LabMap::LabMap(QWidget *parent)
     starterPromptLabel->hide();
     starterPromptLabel->raise();
 
-    starters.append({"Bulbasaur", "GRASS", ":/Battle/assets/pokemon_sprites/001_bulbasaur/front.png"});
-    starters.append({"Charmander", "FIRE", ":/Battle/assets/pokemon_sprites/004_charmander/front.png"});
-    starters.append({"Squirtle", "WATER", ":/Battle/assets/pokemon_sprites/007_squirtle/front.png"});
+    starters.append({"Bulbasaur", "GRASS", 1});
+    starters.append({"Charmander", "FIRE", 4});
+    starters.append({"Squirtle", "WATER", 7});
 
     dialogueParts.append("There you are! I'm Professor Oak!");
 
@@ -239,10 +238,10 @@ LabMap::LabMap(QWidget *parent)
 
     connect(&typeTimer, &QTimer::timeout, this, &LabMap::typeNextCharacter);
     connect(&glowTimer, &QTimer::timeout, this, &LabMap::updatePromptGlow);
-    connect(&gameTimer, &QTimer::timeout, this, &LabMap::gameLoop);
+    connect(&gameLoop, &GameLoop::tick, this, &LabMap::onGameTick);
     connect(&selectionShimmerTimer, &QTimer::timeout, this, &LabMap::updateSelectionShimmer);
 
-    gameTimer.start(16);
+    gameLoop.start();
 }
 LabMap::~LabMap()
 {
@@ -303,7 +302,7 @@ void LabMap::showStarterSelection()
 
         starterNames[i]->setText(starters[i].name);
 
-        QPixmap sprite(starters[i].spritePath);
+        QPixmap sprite = SpriteCache::pokemon(starters[i].dexNumber, true);
         if (!sprite.isNull()) {
             QPixmap scaledSprite = sprite.scaled(80, 80, Qt::KeepAspectRatio, Qt::SmoothTransformation);
             starterSprites[i]->setPixmap(scaledSprite);
@@ -424,21 +423,20 @@ void LabMap::startDialogue()
 void LabMap::startTyping(const QString &text)
 {
     currentFullText = text;
-    currentDisplayText = "";
     typeIndex = 0;
     isTyping = true;
     promptLabel->hide();
     glowTimer.stop();
-    dialogueLabel->setText("");
+    dialogueLabel->setText(text);  // Laid out once; typing only reveals it
+    dialogueLabel->setVisibleCount(0);
     typeTimer.start(30);
 }
 
 void LabMap::typeNextCharacter()
 {
     if (typeIndex < currentFullText.length()) {
-        currentDisplayText += currentFullText[typeIndex];
-        dialogueLabel->setText(currentDisplayText);
         typeIndex++;
+        dialogueLabel->setVisibleCount(typeIndex);
     } else {
         typeTimer.stop();
         isTyping = false;
@@ -472,7 +470,7 @@ void LabMap::updatePromptGlow()
     promptLabel->setStyleSheet(style);
 }
 
-void LabMap::handleMovement()
+void LabMap::handleMovement(qreal dt)
 {
     if (dialogueActive && !dialogueFinished) return;
     if (isSelectingStarter) return;
@@ -506,7 +504,8 @@ void LabMap::handleMovement()
         player->startAnimation();
 
         QPointF oldPos = player->getPosition();
-        QPointF newPos = oldPos + QPointF(dx * speed, dy * speed);
+        const qreal step = speed * dt;
+        QPointF newPos = oldPos + QPointF(dx * step, dy * step);
 
         int checkX = newPos.x() + player->boundingRect().width() * player->scale() / 2;
         int checkY = newPos.y() + player->boundingRect().height() * player->scale() - 4;
@@ -546,16 +545,16 @@ void LabMap::checkExitTransition()
 
     if (pos.y() >= 220 && pos.x() >= 200 && pos.x() <= 280) {
         if (!chosenStarter.isEmpty()) {
-            gameTimer.stop();
+            gameLoop.stop();
             player->stopAnimation();
             emit exitToOverworld();
         }
     }
 }
 
-void LabMap::gameLoop()
+void LabMap::onGameTick(qreal dt)
 {
-    handleMovement();
+    handleMovement(dt);
 }
 
 void LabMap::keyPressEvent(QKeyEvent *event)
@@ -593,7 +592,7 @@ void LabMap::keyPressEvent(QKeyEvent *event)
 
             if (isTyping) {
                 typeTimer.stop();
-                dialogueLabel->setText(currentFullText);
+                dialogueLabel->setVisibleCount(currentFullText.length());
                 isTyping = false;
                 promptLabel->show();
                 glowIntensity = 0.0f;
@@ -676,9 +675,7 @@ void LabMap::showEvent(QShowEvent *event)
     }
 
     // Restart game loop when returning to lab
-    if (!gameTimer.isActive()) {
-        gameTimer.start(16);
-    }
+    gameLoop.start();
 }
 
 void LabMap::setPlayerSpawnPosition(const QPointF &pos)
@@ -13,6 +13,8 @@
 #include <QVector>
 #include "Player_OW.h"
 #include "../General/gamepad.h"
+#include "../General/game_loop.h"
+#include "../General/glyph_text.h"
 #include <cmath>
 
 class LabMap : public QWidget
@@ -36,13 +38,13 @@ protected:
 private slots:
     void typeNextCharacter();
     void updatePromptGlow();
-    void gameLoop();
+    void onGameTick(qreal dt);
     void handleGamepadInput(int type, int code, int value);
 
 private:
     void startDialogue();
     void startTyping(const QString &text);
-    void handleMovement();
+    void handleMovement(qreal dt);
     void checkExitTransition();
     void checkNPCInteraction();
     bool isSolidPixel(int x, int y) const;
@@ -60,7 +62,7 @@ private:
     QLabel *nameBoxLabel;
     QLabel *nameLabel;
     QLabel *textBoxLabel;
-    QLabel *dialogueLabel;
+    GlyphLabel *dialogueLabel;
     QLabel *promptLabel;
 
     QVector<QLabel*> starterBoxes;
@@ -75,11 +77,10 @@ private:
 
     QTimer typeTimer;
     QTimer glowTimer;
-    QTimer gameTimer;
+    GameLoop gameLoop;
     QTimer selectionShimmerTimer;
 
     QString currentFullText;
-    QString currentDisplayText;
     int typeIndex;
     bool isTyping;
     float glowIntensity;
@@ -94,7 +95,7 @@ private:
     QString chosenStarter;
 
     QSet<int> keysPressed;
-    float speed;
+    float speed;  // Pixels per second
 
     QImage collisionMask;
     int bgXOffset;
@@ -103,7 +104,7 @@ private:
     struct StarterPokemon {
         QString name;
         QString type;
-        QString spritePath;
+        int dexNumber;
     };
     QVector<StarterPokemon> starters;
     
@@ -1,52 +1,133 @@
 #include "map_loader.h"
 #include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 
-MapData MapLoader::load(const QString &name)
+static const char *kBuiltinManifest = ":/assets/maps/maps.json";
+
+// Resource paths and absolute paths are kept; anything else is relative to the manifest
+static QString resolvePath(const QDir &base, const QString &path)
 {
-    MapData m;
+    if (path.isEmpty() || path.startsWith(":") || QDir::isAbsolutePath(path))
+        return path;
+    return base.filePath(path);
+}
 
-    // --------------------
-    // Route 6 Example Map
-    // --------------------
-    if (name == "route6")
-    {
-        m.background = ":/assets/maps/route6/background.png";
-        m.collision  = ":/assets/maps/route6/collision.png";
-        m.tallgrass  = ":/assets/maps/route6/tallgrass.png";
-        m.exitMask   = "";  // No exit mask for route6 yet
+static QPointF readPoint(const QJsonValue &value)
+{
+    QJsonArray xy = value.toArray();
+    return QPointF(xy.at(0).toDouble(), xy.at(1).toDouble());
+}
 
-        m.playerSpawn = QPointF(160, 300);
+MapLoader::Manifest MapLoader::parseManifest(const QString &path)
+{
+    Manifest result;
 
-        m.exits["house1_door"] = "route6_house1";
-        m.exits["cave_entrance"] = "viridian_cave";
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Cannot open map manifest:" << path;
+        return result;
+    }
 
-        return m;
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (doc.isNull()) {
+        qDebug() << "Map manifest" << path << "is not valid JSON:" << error.errorString();
+        return result;
     }
 
-    // ---------------------------------
-    // Interior Example (House)
-    // ---------------------------------
-    if (name == "route6_house1")
-    {
-        m.background = ":/assets/maps/house1/background.png";
-        m.collision  = ":/assets/maps/house1/collision.png";
-        m.tallgrass  = "";
-        m.exitMask   = ":/assets/maps/house1/exits.png";
+    const QDir base = QFileInfo(path).absoluteDir();
+    const QJsonObject root = doc.object();
+    result.defaultMap = root.value("defaultMap").toString();
 
-        m.playerSpawn = QPointF(120, 200);
+    const QJsonObject maps = root.value("maps").toObject();
+    for (auto it = maps.constBegin(); it != maps.constEnd(); ++it) {
+        const QJsonObject def = it.value().toObject();
+        const QJsonObject layers = def.value("layers").toObject();
+        const QJsonObject masks = def.value("masks").toObject();
 
-        m.exits["exit_door"] = "route6";
+        MapData m;
+        m.background = resolvePath(base, layers.value("background").toString());
+        m.chunkDir   = resolvePath(base, layers.value("chunks").toString());
+        m.collision  = resolvePath(base, masks.value("collision").toString());
+        m.tallgrass  = resolvePath(base, masks.value("tallgrass").toString());
+        m.exitMask   = resolvePath(base, masks.value("exits").toString());
 
-        return m;
+        m.playerSpawn = readPoint(def.value("spawn"));
+
+        const QJsonObject exits = def.value("exits").toObject();
+        for (auto exit = exits.constBegin(); exit != exits.constEnd(); ++exit) {
+            m.exits[exit.key()] = exit.value().toString();
+        }
+
+        m.encounterRate = def.value("encounterRate").toInt(m.encounterRate);
+        for (const QJsonValue &value : def.value("encounters").toArray()) {
+            const QJsonObject row = value.toObject();
+            EncounterSlot slot;
+            slot.dexNumber = row.value("dex").toInt();
+            slot.minLevel = row.value("minLevel").toInt(1);
+            slot.maxLevel = qMax(slot.minLevel, row.value("maxLevel").toInt(slot.minLevel));
+            slot.weight = row.value("weight").toInt(1);
+            slot.zone = row.value("zone").toInt(0);
+            m.encounters.append(slot);
+        }
+
+        result.maps.insert(it.key(), m);
     }
 
+    qDebug() << "Loaded" << result.maps.size() << "maps from" << path;
+    return result;
+}
+
+const MapLoader::Manifest& MapLoader::manifest()
+{
+    // Static local: parsed once, and safe to reach first from the map streaming thread
+    static const Manifest loaded = []() {
+        QString path = qEnvironmentVariable("POKELITE_MAPS");
+        if (!path.isEmpty()) {
+            Manifest fromDisk = parseManifest(path);
+            if (!fromDisk.maps.isEmpty())
+                return fromDisk;
+            qDebug() << "Falling back to built-in map manifest";
+        }
+        return parseManifest(kBuiltinManifest);
+    }();
+    return loaded;
+}
+
+MapData MapLoader::load(const QString &name)
+{
+    const Manifest &maps = manifest();
+
+    auto it = maps.maps.constFind(name);
+    if (it != maps.maps.constEnd())
+        return it.value();
+
     qDebug() << "Unknown map:" << name;
 
-    m.background = ":/assets/maps/default/background.png";
-    m.collision  = ":/assets/maps/default/collision.png";
-    m.tallgrass  = "";
-    m.exitMask   = "";
-    m.playerSpawn = QPointF(80, 80);
+    // Fall back to the default map rather than a blank scene
+    it = maps.maps.constFind(maps.defaultMap);
+    if (it != maps.maps.constEnd())
+        return it.value();
+
+    return MapData();
+}
+
+bool MapLoader::hasMap(const QString &name)
+{
+    return manifest().maps.contains(name);
+}
 
-    return m;
+QStringList MapLoader::mapNames()
+{
+    return manifest().maps.keys();
+}
+
+QString MapLoader::defaultMap()
+{
+    return manifest().defaultMap;
 }
@@ -2,12 +2,26 @@
 #define MAP_LOADER_H
 
 #include <QString>
+#include <QStringList>
 #include <QPointF>
 #include <QMap>
+#include <QHash>
+#include <QVector>
+
+// One row of a map's wild encounter table
+struct EncounterSlot
+{
+    int dexNumber = 0;
+    int minLevel = 1;
+    int maxLevel = 1;
+    int weight = 1;  // Relative chance within the table
+    int zone = 0;    // Grass zone (0-3) in the tall grass mask, see Map_OW
+};
 
 struct MapData
 {
     QString background;
+    QString chunkDir;   // Optional pre-cut background chunks ("<col>_<row>.png")
     QString collision;
     QString tallgrass;
     QString exitMask;
@@ -15,12 +29,31 @@ struct MapData
     QPointF playerSpawn;
 
     QMap<QString, QString> exits;
+
+    QVector<EncounterSlot> encounters;
+    int encounterRate = 2;  // Percent chance per roll while walking in tall grass
 };
 
+// Maps are defined in a JSON manifest (assets/maps/maps.json, built into the
+// resources). POKELITE_MAPS can point at a manifest on disk instead, so maps
+// can be added or tweaked without a rebuild; relative paths in it are taken
+// from the manifest's folder. The manifest is parsed once, on first use.
 class MapLoader
 {
 public:
     static MapData load(const QString &name);
+    static bool hasMap(const QString &name);
+    static QStringList mapNames();
+    static QString defaultMap();
+
+private:
+    struct Manifest {
+        QString defaultMap;
+        QHash<QString, MapData> maps;
+    };
+
+    static const Manifest& manifest();
+    static Manifest parseManifest(const QString &path);
 };
 
 #endif // MAP_LOADER_H
@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""
+Script to validate the map manifest (assets/maps/maps.json) before a build.
+Checks that every referenced image exists (and, for ":/" resource paths, is
+listed in assets.qrc), that spawns fall inside the map, that exits lead to
+defined maps, that encounter tables are sane and that every grass zone they
+use is painted in the tall grass mask. Exits non-zero on errors.
+
+Usage: validate_maps.py [path/to/maps.json] [path/to/assets.qrc]
+"""
+
+import json
+import os
+import struct
+import sys
+import xml.etree.ElementTree as ET
+import zlib
+
+# Exit names Map_OW::exitName() can report (red, blue, green in the exit mask)
+KNOWN_EXITS = {"house1_door", "cave_entrance", "exit_door"}
+
+def png_size(path):
+    """Width and height from a PNG's IHDR chunk, or None."""
+    with open(path, 'rb') as f:
+        header = f.read(24)
+    if len(header) < 24 or header[:8] != b'\x89PNG\r\n\x1a\n':
+        return None
+    return struct.unpack('>II', header[16:24])
+
+def png_rows(path):
+    """(width, channels, [row bytes]) for an 8-bit RGB/RGBA, non-interlaced
+    PNG, or None for anything else. Just enough to read the masks."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        return None
+
+    pos = 8
+    idat = b''
+    header = None
+    while pos + 8 <= len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if kind == b'IHDR':
+            header = struct.unpack('>IIBBBBB', body)
+        elif kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+        pos += 12 + length
+
+    if not header:
+        return None
+    width, height, depth, color_type, _, _, interlace = header
+    channels = {2: 3, 6: 4}.get(color_type)
+    if depth != 8 or not channels or interlace:
+        return None
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        kind = raw[start]
+        row = bytearray(raw[start + 1:start + 1 + stride])
+        for x in range(stride):
+            left = row[x - channels] if x >= channels else 0
+            up = previous[x]
+            up_left = previous[x - channels] if x >= channels else 0
+            if kind == 1:
+                row[x] = (row[x] + left) & 0xFF
+            elif kind == 2:
+                row[x] = (row[x] + up) & 0xFF
+            elif kind == 3:
+                row[x] = (row[x] + (left + up) // 2) & 0xFF
+            elif kind == 4:
+                p = left + up - up_left
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+                pred = left if pa <= pb and pa <= pc else (up if pb <= pc else up_left)
+                row[x] = (row[x] + pred) & 0xFF
+        rows.append(row)
+        previous = row
+    return width, channels, rows
+
+def grass_zones(path):
+    """Grass zones painted in a tall grass mask, classified like
+    Map_OW::buildAttributeGrid (magenta, zone = green / 25), or None if
+    the PNG can't be read here."""
+    decoded = png_rows(path)
+    if not decoded:
+        return None
+    width, channels, rows = decoded
+    zones = set()
+    for row in rows:
+        for x in range(0, width * channels, channels):
+            r, g, b = row[x], row[x + 1], row[x + 2]
+            if r > 200 and b > 200 and g < 100:
+                zones.add(g // 25)
+    return zones
+
+def load_qrc_files(qrc_path):
+    """Resource paths (":/...") listed in a .qrc file."""
+    if not os.path.exists(qrc_path):
+        return None
+    files = set()
+    for qresource in ET.parse(qrc_path).getroot().iter('qresource'):
+        prefix = qresource.get('prefix', '/').rstrip('/')
+        for entry in qresource.iter('file'):
+            files.add(':' + prefix + '/' + (entry.get('alias') or entry.text.strip()))
+    return files
+
+def validate(manifest_path, qrc_path):
+    errors = []
+    manifest_dir = os.path.dirname(os.path.abspath(manifest_path))
+    src_dir = os.path.dirname(os.path.abspath(qrc_path))
+    qrc_files = load_qrc_files(qrc_path)
+
+    def resolve(path):
+        if path.startswith(':/'):
+            return os.path.join(src_dir, path[2:])
+        if os.path.isabs(path):
+            return path
+        return os.path.join(manifest_dir, path)
+
+    def check_file(map_name, what, path, required):
+        if not path:
+            if required:
+                errors.append(f"{map_name}: missing {what}")
+            return None
+        if path.startswith(':/') and qrc_files is not None and path not in qrc_files:
+            errors.append(f"{map_name}: {what} {path} is not listed in {os.path.basename(qrc_path)}")
+        resolved = resolve(path)
+        if not os.path.exists(resolved):
+            errors.append(f"{map_name}: {what} {path} does not exist")
+            return None
+        return resolved
+
+    with open(manifest_path, 'r', encoding='utf-8') as f:
+        try:
+            manifest = json.load(f)
+        except json.JSONDecodeError as e:
+            return [f"{manifest_path}: invalid JSON: {e}"]
+
+    maps = manifest.get('maps', {})
+    if not maps:
+        errors.append("manifest defines no maps")
+    if manifest.get('defaultMap') not in maps:
+        errors.append(f"defaultMap '{manifest.get('defaultMap')}' is not defined")
+
+    for name, definition in maps.items():
+        layers = definition.get('layers', {})
+        masks = definition.get('masks', {})
+
+        background = check_file(name, "background", layers.get('background', ''), True)
+        collision = check_file(name, "collision mask", masks.get('collision', ''), True)
+        tallgrass = check_file(name, "tall grass mask", masks.get('tallgrass', ''), False)
+        exit_mask = check_file(name, "exit mask", masks.get('exits', ''), False)
+
+        chunks = layers.get('chunks', '')
+        if chunks and not os.path.isdir(resolve(chunks)):
+            errors.append(f"{name}: chunk folder {chunks} does not exist")
+
+        size = png_size(background) if background else None
+        if collision and size and png_size(collision) != size:
+            errors.append(f"{name}: collision mask size differs from the background")
+
+        spawn = definition.get('spawn')
+        if not (isinstance(spawn, list) and len(spawn) == 2 and all(isinstance(v, (int, float)) for v in spawn)):
+            errors.append(f"{name}: spawn must be [x, y]")
+        elif size and not (0 <= spawn[0] < size[0] and 0 <= spawn[1] < size[1]):
+            errors.append(f"{name}: spawn {spawn} is outside the {size[0]}x{size[1]} map")
+
+        exits = definition.get('exits', {})
+        if exits and not exit_mask:
+            errors.append(f"{name}: has exits but no exit mask")
+        for exit_name, target in exits.items():
+            if exit_name not in KNOWN_EXITS:
+                errors.append(f"{name}: unknown exit '{exit_name}' (expected one of {sorted(KNOWN_EXITS)})")
+            if target not in maps:
+                errors.append(f"{name}: exit '{exit_name}' leads to undefined map '{target}'")
+
+        rate = definition.get('encounterRate', 2)
+        if not (isinstance(rate, int) and 0 <= rate <= 100):
+            errors.append(f"{name}: encounterRate must be a percentage (0-100)")
+
+        for i, slot in enumerate(definition.get('encounters', [])):
+            dex = slot.get('dex', 0)
+            low = slot.get('minLevel', 1)
+            high = slot.get('maxLevel', low)
+            if not 1 <= dex <= 151:
+                errors.append(f"{name}: encounter {i} has dex {dex} outside 1-151")
+            if not 1 <= low <= high <= 100:
+                errors.append(f"{name}: encounter {i} has bad level range {low}-{high}")
+            if slot.get('weight', 1) <= 0:
+                errors.append(f"{name}: encounter {i} needs a positive weight")
+            if not 0 <= slot.get('zone', 0) <= 3:
+                errors.append(f"{name}: encounter {i} zone must be 0-3")
+
+        # A row for a zone the mask doesn't paint can never be rolled
+        encounter_zones = {slot.get('zone', 0) for slot in definition.get('encounters', [])}
+        if encounter_zones:
+            painted = grass_zones(tallgrass) if tallgrass else set()
+            if painted is not None:
+                for zone in sorted(encounter_zones - painted):
+                    errors.append(f"{name}: encounters use grass zone {zone}, "
+                                  f"but the tall grass mask has no zone {zone} pixels "
+                                  f"(painted: {sorted(painted) or 'none'})")
+
+    return errors
+
+if __name__ == "__main__":
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    manifest_file = os.path.join(script_dir, "..", "assets", "maps", "maps.json")
+    qrc_file = os.path.join(script_dir, "..", "assets.qrc")
+
+    # Allow command line arguments
+    if len(sys.argv) > 1:
+        manifest_file = sys.argv[1]
+    if len(sys.argv) > 2:
+        qrc_file = sys.argv[2]
+
+    if not os.path.exists(manifest_file):
+        print(f"Error: File {manifest_file} not found")
+        sys.exit(1)
+
+    problems = validate(manifest_file, qrc_file)
+    for problem in problems:
+        print(f"maps.json: {problem}")
+
+    if problems:
+        sys.exit(1)
+    print(f"Map manifest {manifest_file} is valid")
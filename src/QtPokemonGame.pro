@@ -6,24 +6,49 @@ CONFIG += c++17
 
 INCLUDEPATH += Battle/Battle_logic/json
 
+# openpty() for the pseudo-terminal link transport
+LIBS += -lutil
+
+# Frame profiler zones and overlay (General/frame_profiler.h). On in debug
+# builds; add CONFIG+=profile to a release build to measure it as shipped.
+CONFIG(debug, debug|release)|profile {
+    DEFINES += POKELITE_PROFILE
+}
+
 SOURCES += \
     General/fadeeffect.cpp \
     General/main.cpp \
     General/window.cpp \
     General/gamepad.cpp \
     General/uart_comm.cpp \
+    General/link_transport.cpp \
+    General/link_io_thread.cpp \
+    General/game_loop.cpp \
+    General/game_view.cpp \
+    General/framebuffer_renderer.cpp \
+    General/sprite_cache.cpp \
+    General/glyph_text.cpp \
+    General/frame_profiler.cpp \
     Intro_Screen/introscreen.cpp \
     Intro_Screen/lorescreen.cpp \
     Overworld/Overworld.cpp \
     Overworld/Player_OW.cpp \
     Overworld/Camera_OW.cpp \
     Overworld/Map_OW.cpp \
+    Overworld/Collision_OW.cpp \
+    Overworld/MapStreamer_OW.cpp \
+    Overworld/EncounterTable_OW.cpp \
     Overworld/Menu_OW.cpp \
     Overworld/labmap.cpp \
     Overworld/map_loader.cpp \
     Battle/GUI_BT.cpp \
     Battle/BattleState_BT.cpp \
     Battle/Animations_BT.cpp \
+    Battle/EffectPool_BT.cpp \
+    Battle/BattleTimeline_BT.cpp \
+    Battle/HpBar_BT.cpp \
+    Battle/BattleSync_BT.cpp \
+    Battle/SpriteAtlas_BT.cpp \
     Battle/Battle_logic/Attack.cpp \
     Battle/Battle_logic/Bag.cpp \
     Battle/Battle_logic/Battle.cpp \
@@ -39,18 +64,35 @@ HEADERS += \
     General/window.h \
     General/gamepad.h \
     General/uart_comm.h \
+    General/link_transport.h \
+    General/link_io_thread.h \
+    General/spsc_queue.h \
+    General/game_loop.h \
+    General/game_view.h \
+    General/framebuffer_renderer.h \
+    General/sprite_cache.h \
+    General/glyph_text.h \
+    General/frame_profiler.h \
     Intro_Screen/introscreen.h \
     Intro_Screen/lorescreen.h \
     Overworld/Overworld.h \
     Overworld/Player_OW.h \
     Overworld/Camera_OW.h \
     Overworld/Map_OW.h \
+    Overworld/Collision_OW.h \
+    Overworld/MapStreamer_OW.h \
+    Overworld/EncounterTable_OW.h \
     Overworld/Menu_OW.h \
     Overworld/labmap.h \
     Overworld/map_loader.h \
     Battle/GUI_BT.h \
     Battle/BattleState_BT.h \
     Battle/Animations_BT.h \
+    Battle/EffectPool_BT.h \
+    Battle/BattleTimeline_BT.h \
+    Battle/HpBar_BT.h \
+    Battle/BattleSync_BT.h \
+    Battle/SpriteAtlas_BT.h \
     Battle/Battle_logic/Attack.h \
     Battle/Battle_logic/Bag.h \
     Battle/Battle_logic/Battle.h \
@@ -64,6 +106,18 @@ HEADERS += \
 
 RESOURCES += assets.qrc
 
+# Check the map manifest (missing assets, dangling exits) before every build
+validate_maps.target = validate_maps
+validate_maps.commands = python3 $$PWD/Overworld/validate_maps.py $$PWD/assets/maps/maps.json $$PWD/assets.qrc
+QMAKE_EXTRA_TARGETS += validate_maps
+PRE_TARGETDEPS += validate_maps
+
+# Repack the battle sprite atlas after changing sprites (make pack_sprite_atlas);
+# the output is checked in, so this is not part of the normal build
+pack_sprite_atlas.target = pack_sprite_atlas
+pack_sprite_atlas.commands = python3 $$PWD/Battle/pack_sprite_atlas.py $$PWD/Battle/assets/pokemon_sprites $$PWD/Battle/assets/atlas
+QMAKE_EXTRA_TARGETS += pack_sprite_atlas
+
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
@@ -0,0 +1,29 @@
+QT       += core gui widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = pokelite_bench
+
+# The game's own sources, minus its main(). Globbed so new game files are
+# picked up without editing this file.
+GAME_DIR = $$PWD/..
+
+INCLUDEPATH += $$GAME_DIR/Battle/Battle_logic/json
+
+# openpty() for the pseudo-terminal link transport
+LIBS += -lutil
+
+# The battle data is read from paths relative to src/
+DEFINES += POKELITE_SRC_DIR=\\\"$$GAME_DIR\\\"
+
+GAME_SOURCE_DIRS = General Intro_Screen Overworld Battle Battle/Battle_logic
+for(dir, GAME_SOURCE_DIRS) {
+    SOURCES += $$files($$GAME_DIR/$$dir/*.cpp)
+    HEADERS += $$files($$GAME_DIR/$$dir/*.h)
+}
+SOURCES -= $$GAME_DIR/General/main.cpp
+
+SOURCES += bench_main.cpp
+
+RESOURCES += $$GAME_DIR/assets.qrc
@@ -0,0 +1,405 @@
+// Headless benchmarks for the game. Runs under Qt's offscreen platform and
+// prints one JSON document with every result, so runs can be diffed across
+// releases. See README.md in this folder.
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QGraphicsView>
+#include <QKeyEvent>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QTimer>
+#include <functional>
+#include <iostream>
+#include <streambuf>
+
+#include "../General/window.h"
+#include "../General/sprite_cache.h"
+#include "../Overworld/Map_OW.h"
+#include "../Overworld/map_loader.h"
+#include "../Overworld/MapStreamer_OW.h"
+#include "../Battle/GUI_BT.h"
+#include "../Battle/BattleState_BT.h"
+#include "../Battle/Battle_logic/Battle.h"
+#include "../Battle/Battle_logic/Player.h"
+#include "../Battle/Battle_logic/Pokemon.h"
+#include "../Battle/Battle_logic/PokemonData.h"
+
+namespace {
+
+QElapsedTimer processClock;   // Started first thing in main()
+QJsonArray results;
+QString filter;
+bool verbose = false;
+
+// The battle logic narrates every turn on std::cout; that would be most of
+// what the turn benchmarks measured
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+};
+
+void quietMessages(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Q_UNUSED(context);
+    if (!verbose && (type == QtDebugMsg || type == QtInfoMsg)) return;
+    QTextStream(stderr) << message << "\n";
+}
+
+bool selected(const QString &name)
+{
+    return filter.isEmpty() || name.contains(filter);
+}
+
+void report(const QString &name, double value, const QString &unit, int iterations)
+{
+    QJsonObject result;
+    result["name"] = name;
+    result["value"] = value;
+    result["unit"] = unit;
+    result["iterations"] = iterations;
+    results.append(result);
+
+    QTextStream(stderr) << name << ": " << value << " " << unit << "\n";
+}
+
+double elapsedMs(const QElapsedTimer &timer)
+{
+    return timer.nsecsElapsed() / 1e6;
+}
+
+// ================================================
+// Benchmarks
+// ================================================
+
+void benchDatabaseLoad()
+{
+    // Parsed once per process, so this runs before anything else touches it
+    QElapsedTimer timer;
+    timer.start();
+    initializePokemonDataFromJSON();
+    report("database_load", elapsedMs(timer), "ms", 1);
+}
+
+void benchBootToFirstFrame()
+{
+    // From process start: QApplication, the database, the window with its
+    // map, and the first frame rendered
+    Window window;
+    window.setPlayerSpawnPosition(QPointF(303, 210));
+    window.show();
+    QApplication::processEvents();
+    const QPixmap frame = window.grab();
+    Q_UNUSED(frame);
+    report("boot_to_first_frame", elapsedMs(processClock), "ms", 1);
+}
+
+void benchMapLoad()
+{
+    const QString name = MapLoader::defaultMap();
+    constexpr int kIterations = 5;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kIterations; ++i) {
+        Map_OW::prepareMap(name);
+    }
+    report("map_prepare", elapsedMs(timer) / kIterations, "ms", kIterations);
+}
+
+void benchMapSwap()
+{
+    // What walking through an exit costs: the next map is prefetched on the
+    // streamer's worker, then swapped into the scene. Alternates with another
+    // map from the manifest when there is one, otherwise swaps in a freshly
+    // prepared copy of the default map.
+    const QString home = MapLoader::defaultMap();
+    QString other = home;
+    for (const QString &name : MapLoader::mapNames()) {
+        if (name != home) {
+            other = name;
+            break;
+        }
+    }
+    constexpr int kIterations = 10;
+    constexpr qint64 kTimeoutMs = 5000;
+
+    Map_OW map;
+    MapStreamer_OW streamer;
+    map.setStreamer(&streamer);
+    map.loadMap(home);
+
+    double prefetchMs = 0;
+    double swapMs = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        const QString target = (i % 2 == 0) ? other : home;
+        streamer.retainOnly({});  // Nothing left over, so every prefetch decodes
+
+        QElapsedTimer timer;
+        timer.start();
+        streamer.prefetch(target);
+        while (!streamer.isReady(target) && timer.elapsed() < kTimeoutMs) {
+            QApplication::processEvents(QEventLoop::AllEvents, 10);
+        }
+        prefetchMs += elapsedMs(timer);
+        if (!streamer.isReady(target)) {
+            QTextStream(stderr) << "map_swap: prefetch of " << target << " timed out\n";
+        }
+
+        // The swap is the only part the player waits for
+        timer.restart();
+        map.applyPreparedMap(streamer.take(target));
+        map.updateVisibleChunks(QRectF(0, 0, 240, 160));
+        swapMs += elapsedMs(timer);
+    }
+    report("map_prefetch", prefetchMs / kIterations, "ms", kIterations);
+    report("map_swap", swapMs / kIterations, "ms", kIterations);
+}
+
+void benchPokemonConstruction()
+{
+    constexpr int kIterations = 20000;
+    int sink = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kIterations; ++i) {
+        Pokemon pokemon(1 + i % 151, 5 + i % 50);
+        sink += pokemon.getMaxHP();
+    }
+    const double ms = elapsedMs(timer);
+    Q_UNUSED(sink);
+    report("pokemon_construction", kIterations / (ms / 1000.0), "per_s", kIterations);
+}
+
+void benchTurnResolution()
+{
+    // Wild battles between matched levels, fought to the end with the first move
+    constexpr int kBattles = 2000;
+    int turns = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kBattles; ++i) {
+        Player player("Bench", PlayerType::HUMAN);
+        Player wild("Wild", PlayerType::NPC);
+        player.addPokemon(Pokemon(1 + (i * 7) % 151, 30));
+        wild.addPokemon(Pokemon(1 + (i * 13) % 151, 30));
+
+        Battle battle(&player, &wild, true);
+        // Turn cap: a pair with no damaging moves left would never finish
+        for (int t = 0; t < 200 && !battle.isBattleOver(); ++t) {
+            battle.executeTurn(0, 0);
+            ++turns;
+        }
+    }
+    const double ms = elapsedMs(timer);
+    report("turn_resolution", turns / (ms / 1000.0), "per_s", turns);
+}
+
+void benchCollisionQueries()
+{
+    const QSharedPointer<const PreparedMap> map = Map_OW::prepareMap(MapLoader::defaultMap());
+    const Collision_OW &collision = map->collision;
+    if (collision.width() == 0) {
+        QTextStream(stderr) << "collision_sweep: default map has no collision mask, skipped\n";
+        return;
+    }
+
+    // Same foot size and step lengths as walking; fixed seed so runs compare
+    constexpr int kIterations = 1000000;
+    QRandomGenerator random(1234);
+    qreal sink = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kIterations; ++i) {
+        const QRectF foot(random.bounded(collision.width()), random.bounded(collision.height()), 4, 6);
+        const QPointF delta(random.bounded(9) - 4, random.bounded(9) - 4);
+        sink += collision.sweep(foot, delta).x();
+    }
+    const double ms = elapsedMs(timer);
+    Q_UNUSED(sink);
+    report("collision_sweep", kIterations / (ms / 1000.0), "per_s", kIterations);
+}
+
+void benchSpriteLoad()
+{
+    constexpr int kSpecies = 151;
+    SpriteCache::setBudgetKb(64 * 1024);  // Room for all of them, so the second pass only hits
+    SpriteCache::clear();
+    SpriteCache::resetCounters();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int dex = 1; dex <= kSpecies; ++dex) {
+        SpriteCache::pokemon(dex, true);
+        SpriteCache::pokemon(dex, false);
+    }
+    report("sprite_load_cold", elapsedMs(timer) / (kSpecies * 2), "ms", kSpecies * 2);
+
+    timer.restart();
+    for (int dex = 1; dex <= kSpecies; ++dex) {
+        SpriteCache::pokemon(dex, true);
+        SpriteCache::pokemon(dex, false);
+    }
+    report("sprite_load_cached", elapsedMs(timer) * 1000.0 / (kSpecies * 2), "us", kSpecies * 2);
+    report("sprite_cache_kb", SpriteCache::usedKb(), "kb", kSpecies * 2);
+}
+
+void benchFullBattle()
+{
+    // The real battle scene, driven by pressing A whenever it will take it.
+    // POKELITE_BATTLE_SPEED=instant (set in main) takes the animation time
+    // out, so this is the cost of the battle code and the scene updates.
+    constexpr int kBattles = 10;
+    constexpr qint64 kTimeoutMs = 30000;
+
+    // Declared first: the sequence emits battleEnded again when it is destroyed
+    bool ended = false;
+
+    QGraphicsView view;
+    BattleSequence sequence(&view);
+    QObject::connect(&sequence, &BattleSequence::battleEnded, [&ended]() { ended = true; });
+
+    SpriteCache::resetCounters();
+    int completed = 0;
+    int presses = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kBattles; ++i) {
+        Player player("Bench", PlayerType::HUMAN);
+        Player wild("Wild", PlayerType::NPC);
+        player.addPokemon(Pokemon(6, 40));
+        wild.addPokemon(Pokemon(1 + (i * 17) % 151, 20));
+
+        BattleSystem battleSystem;
+        battleSystem.initializeBattle(&player, &wild, true);
+
+        ended = false;
+        QElapsedTimer battleTimer;
+        battleTimer.start();
+        sequence.startBattle(&player, &wild, &battleSystem);
+        while (!ended && battleTimer.elapsed() < kTimeoutMs) {
+            QApplication::processEvents();
+            QKeyEvent press(QEvent::KeyPress, Qt::Key_Return, Qt::NoModifier);
+            sequence.handleBattleKey(&press);
+            ++presses;
+        }
+        if (ended) {
+            ++completed;
+        } else {
+            QTextStream(stderr) << "full_battle: battle " << i << " timed out\n";
+            sequence.closeBattle();
+        }
+    }
+    const double ms = elapsedMs(timer);
+
+    report("full_battle", ms / kBattles, "ms", kBattles);
+    report("full_battle_completed", completed, "count", kBattles);
+    report("full_battle_presses", double(presses) / kBattles, "count", kBattles);
+    report("full_battle_sprite_hits", SpriteCache::hits(), "count", kBattles);
+    report("full_battle_sprite_misses", SpriteCache::misses(), "count", kBattles);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    processClock.start();
+
+    // No display needed; both can still be overridden from outside
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    if (qEnvironmentVariableIsEmpty("POKELITE_BATTLE_SPEED")) {
+        qputenv("POKELITE_BATTLE_SPEED", "instant");
+    }
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("pokelite_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Pokelite headless benchmarks");
+    parser.addHelpOption();
+    QCommandLineOption outputOption({"o", "output"}, "Write the JSON results to <file> instead of stdout.", "file");
+    QCommandLineOption filterOption({"f", "filter"}, "Only run benchmarks whose name contains <text>.", "text");
+    QCommandLineOption verboseOption({"v", "verbose"}, "Keep the game's debug logging.");
+    parser.addOption(outputOption);
+    parser.addOption(filterOption);
+    parser.addOption(verboseOption);
+    parser.process(app);
+
+    filter = parser.value(filterOption);
+    verbose = parser.isSet(verboseOption);
+    qInstallMessageHandler(quietMessages);
+
+    // The battle data is read from paths relative to src/
+    QDir::setCurrent(POKELITE_SRC_DIR);
+
+    NullBuffer nullBuffer;
+    std::streambuf *coutBuffer = std::cout.rdbuf(&nullBuffer);
+
+    // Order matters: the database and map manifest are parsed once per
+    // process, so the load and boot numbers come first while they are cold
+    const QVector<QPair<QString, std::function<void()>>> benchmarks = {
+        {"database_load", benchDatabaseLoad},
+        {"boot_to_first_frame", benchBootToFirstFrame},
+        {"map_prepare", benchMapLoad},
+        {"map_swap", benchMapSwap},
+        {"pokemon_construction", benchPokemonConstruction},
+        {"turn_resolution", benchTurnResolution},
+        {"collision_sweep", benchCollisionQueries},
+        {"sprite_load", benchSpriteLoad},
+        {"full_battle", benchFullBattle},
+    };
+    for (const auto &benchmark : benchmarks) {
+        if (selected(benchmark.first)) {
+            benchmark.second();
+        }
+    }
+
+    std::cout.rdbuf(coutBuffer);
+
+    QJsonObject root;
+    root["suite"] = "pokelite";
+    root["qt"] = QString(qVersion());
+#ifdef QT_DEBUG
+    root["build"] = "debug";
+#else
+    root["build"] = "release";
+#endif
+    root["platform"] = QApplication::platformName();
+    root["battle_speed"] = QString::fromLocal8Bit(qgetenv("POKELITE_BATTLE_SPEED"));
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["results"] = results;
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    int status = 0;
+    const QString outputPath = parser.value(outputOption);
+    if (outputPath.isEmpty()) {
+        QTextStream(stdout) << json;
+    } else {
+        QFile file(outputPath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(json);
+        } else {
+            QTextStream(stderr) << "Cannot write " << outputPath << "\n";
+            status = 1;
+        }
+    }
+
+    // Quit through the event loop like the game does, so aboutToQuit
+    // releases the cached pixmaps while QApplication still exists
+    QTimer::singleShot(0, &app, &QCoreApplication::quit);
+    app.exec();
+    return status;
+}